@@ -0,0 +1,308 @@
+#include "BeamSearch.h"
+
+/**
+  * @brief  Constructor of a beam search.
+  * @param  _width  The number of partial paths that are kept per ply
+  * @param  _jitter The maximal random value that is added to the score of a partial path
+  * @param  seed    The seed of the random generator
+  */
+BeamSearch::BeamSearch(uint16_t _width, double _jitter, uint64_t seed) : width(_width), jitter(_jitter) {
+  //The seed is mixed once (splitmix64), so neighbouring seeds give unrelated sequences and the state is never 0
+  uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  this->state = (z ^ (z >> 31)) | 1;
+}
+
+/**
+  * @brief  Returns the next random value of the xorshift64* generator.
+  * @retval A value in [0, 1)
+  */
+double BeamSearch::nextRandom() {
+  this->state ^= this->state >> 12;
+  this->state ^= this->state << 25;
+  this->state ^= this->state >> 27;
+  return ((this->state * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+  * @brief  Runs the beam search from a root.
+  * @param  board The empty chessboard
+  * @param  root  The root of the paths
+  * @retval The board of the longest closed path that was found. Its length is 0 if no path could be closed.
+  */
+Chessboard BeamSearch::run(const Chessboard& board, std::pair<uint8_t, uint8_t> root) {
+  this->longestPath = board;
+  uint16_t fields = board.getWidth() * board.getHeight();
+
+  //The first ply: the root with every move that leaves it
+  std::vector<Node> beam;
+  for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
+    Node node;
+    node.cboard = board;
+    uint16_t index = node.cboard.toIndex(root);
+    if(node.cboard.isFieldReserved(node.cboard.doMove(index, move))) continue;
+
+    node.cboard.setRoot(move, root);
+    node.source = node.cboard.doMove(index, move);
+    node.incoming_move = move;
+    beam.push_back(node);
+  }
+
+  std::vector<Candidate> candidates;
+  std::vector<Node> next;
+  while(!beam.empty()) {
+    candidates.clear();
+    for(uint32_t p = 0; p < beam.size(); p++) {
+      Node& node = beam[p];
+      uint8_t incoming = node.cboard.rotate180(node.incoming_move);
+
+      for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
+        uint16_t target = node.cboard.doMove(node.source, outgoing_move);
+
+        if(!node.cboard.isFieldReserved(target) && !node.cboard.isConnectionCrossesEdge(node.source, outgoing_move)) {
+          //The move is scored on the board of the partial path and reverted, only the kept ones get a copy.
+          //The free fields reachable from the target only decide between equal rollouts.
+          node.cboard.setField(outgoing_move | incoming, node.source);
+          if(node.cboard.isRootReachable(target)) {
+            double score = this->rollout(node.cboard, target, outgoing_move)
+              + (double) node.cboard.countReachable(target, fields) / fields
+              + this->jitter * this->nextRandom();
+            candidates.push_back({p, outgoing_move, score});
+          }
+          node.cboard.unsetField(node.source);
+        }else if(node.cboard.isFinishable(node.source, target, outgoing_move) && outgoing_move != incoming) {
+          //The move back over the first edge isn't a closed path
+          this->close(node.cboard, node.source, node.incoming_move, outgoing_move);
+        }
+      }
+    }
+
+    //The order of equal scores is fixed by the parent and the move, so the result only depends on the seed
+    size_t keep = std::min<size_t>(this->width, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), [](const Candidate& a, const Candidate& b) {
+      if(a.score != b.score) return a.score > b.score;
+      return a.parent != b.parent ? a.parent < b.parent : a.move < b.move;
+    });
+
+    next.clear();
+    for(size_t k = 0; k < keep; k++) {
+      const Candidate& candidate = candidates[k];
+      Node child = beam[candidate.parent];
+      child.cboard.setField(candidate.move | child.cboard.rotate180(child.incoming_move), child.source);
+      child.source = child.cboard.doMove(child.source, candidate.move);
+      child.incoming_move = candidate.move;
+      next.push_back(child);
+    }
+    beam.swap(next);
+  }
+
+  return this->longestPath;
+}
+
+/**
+  * @brief  Counts the valid moves of a field.
+  * @param  cboard The chessboard
+  * @param  source The field index
+  * @retval The number of moves to free fields that don't cross the path
+  */
+uint8_t BeamSearch::countMoves(const Chessboard& cboard, uint16_t source) const {
+  uint8_t count = 0;
+  for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
+    if(!cboard.isFieldReserved(cboard.doMove(source, move)) && !cboard.isConnectionCrossesEdge(source, move)) count++;
+  }
+  return count;
+}
+
+/**
+  * @brief  Continues a partial path greedily until it is stuck: the move with the fewest onward moves is taken,
+  *         equal ones are chosen randomly. Every time the path can be closed on the way, the closed path is a candidate.
+  * @param  board         The board of the partial path, it isn't changed
+  * @param  source        The field index the partial path ends on
+  * @param  incoming_move The move that leads to source
+  * @retval The length of the longest closed path on the way, 0 if the path couldn't be closed
+  */
+uint16_t BeamSearch::rollout(const Chessboard& board, uint16_t source, uint8_t incoming_move) {
+  Chessboard cboard = board;
+  uint16_t longest = 0;
+  while(true) {
+    uint8_t incoming = cboard.rotate180(incoming_move);
+    uint8_t chosen = 0, fewest = MOVE_COUNT + 1;
+    double tie = 1.0;
+
+    for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
+      uint16_t target = cboard.doMove(source, outgoing_move);
+
+      if(!cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(source, outgoing_move)) {
+        cboard.setField(outgoing_move | incoming, source);
+        uint8_t onward = this->countMoves(cboard, target);
+        cboard.unsetField(source);
+
+        double random = this->nextRandom();
+        if(onward < fewest || (onward == fewest && random < tie)) {
+          chosen = outgoing_move;
+          fewest = onward;
+          tie = random;
+        }
+      }else if(cboard.isFinishable(source, target, outgoing_move) && outgoing_move != incoming) {
+        longest = std::max<uint16_t>(longest, cboard.getLength() + 1);
+        this->close(cboard, source, incoming_move, outgoing_move);
+      }
+    }
+
+    if(chosen == 0) return longest;
+    cboard.setField(chosen | incoming, source);
+    source = cboard.doMove(source, chosen);
+    incoming_move = chosen;
+  }
+}
+
+/**
+  * @brief  Closes a partial path with the move back to the root. If it is close to the longest path so far,
+  *         it is extended by the local search and kept if it is the longest one now.
+  * @param  cboard        The board of the partial path, it isn't changed
+  * @param  source        The field index the partial path ends on
+  * @param  incoming_move The move that leads to source
+  * @param  move          The move from source to the root
+  * @retval None
+  */
+void BeamSearch::close(const Chessboard& cboard, uint16_t source, uint8_t incoming_move, uint8_t move) {
+  if(cboard.getLength() + 1 + EXTEND_SLACK <= this->longestPath.getLength()) return;
+
+  Chessboard cpy = cboard;
+  uint16_t root = cpy.getRootIndex();
+  cpy.setField(move | cpy.rotate180(incoming_move), source);
+  cpy.updateField(cpy.at(root) | cpy.rotate180(move), root);
+
+  this->extend(cpy);
+  if(cpy.getLength() > this->longestPath.getLength()) {
+    this->longestPath = cpy;
+  }
+}
+
+/**
+  * @brief  The local search: replaces segments of up to REROUTE_SEGMENT moves by longer uncrossed detours over free
+  *         fields, until no segment can be replaced anymore. Segments that contain the root as inner field are kept.
+  * @param  cboard The board of a closed path, it is changed in place
+  * @retval None
+  */
+void BeamSearch::extend(Chessboard& cboard) {
+  bool improved = true;
+  while(improved) {
+    improved = false;
+    std::vector<uint8_t> moves;
+    std::vector<uint16_t> path = this->getPath(cboard, moves);
+    for(size_t segment = 1; segment <= REROUTE_SEGMENT && !improved; segment++) {
+      for(size_t first = 0; first < path.size() && !improved; first++) {
+        improved = this->reroute(cboard, path, moves, first, segment);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Replaces one segment of a closed path by the longest detour between its end fields.
+  * @param  cboard  The board of the closed path
+  * @param  path    The field indices of the path, starting at the root
+  * @param  moves   The moves of the path, moves[i] leads from path[i] to the next field
+  * @param  first   The position of the first field of the segment
+  * @param  segment The number of moves of the segment
+  * @retval true:   The segment was replaced by a longer one
+  *         false:  There is no longer detour, the board is unchanged
+  */
+bool BeamSearch::reroute(Chessboard& cboard, const std::vector<uint16_t>& path, const std::vector<uint8_t>& moves, size_t first, size_t segment) {
+  size_t length = path.size();
+  for(size_t k = 1; k < segment; k++) {
+    if((first + k) % length == 0) return false;
+  }
+
+  //The inner fields of the segment are freed and its moves are removed from the end fields
+  Chessboard original = cboard;
+  uint16_t begin = path[first], end = path[(first + segment) % length];
+  uint8_t beginMoves = cboard.at(begin) & ~moves[first];
+  uint8_t endMoves = cboard.at(end) & ~cboard.rotate180(moves[(first + segment - 1) % length]);
+  for(size_t k = 1; k < segment; k++) {
+    cboard.unsetField(path[(first + k) % length]);
+  }
+  cboard.updateField(beginMoves, begin);
+  cboard.updateField(endMoves, end);
+
+  std::vector<uint8_t> detour, longest;
+  this->route(cboard, begin, beginMoves, end, detour, longest, segment + REROUTE_DETOUR);
+  if(longest.size() <= segment) {
+    cboard = original;
+    return false;
+  }
+
+  uint16_t current = begin;
+  uint8_t currentMoves = beginMoves;
+  for(size_t k = 0; k < longest.size(); k++) {
+    cboard.updateField(currentMoves | longest[k], current);
+    current = cboard.doMove(current, longest[k]);
+    currentMoves = cboard.rotate180(longest[k]);
+    if(k + 1 < longest.size()) cboard.setField(currentMoves, current);
+  }
+  cboard.updateField(endMoves | currentMoves, end);
+  return true;
+}
+
+/**
+  * @brief  Searches the longest uncrossed path over free fields between two fields by backtracking.
+  * @param  cboard      The board, the path is set in place and removed again
+  * @param  source      The field index of the current field
+  * @param  sourceMoves The moves of the current field without its outgoing move
+  * @param  end         The field index of the end field
+  * @param  detour      The moves of the current path
+  * @param  longest     The moves of the longest path to the end field so far
+  * @param  limit       The maximal number of moves of a path
+  * @retval None
+  */
+void BeamSearch::route(Chessboard& cboard, uint16_t source, uint8_t sourceMoves, uint16_t end, std::vector<uint8_t>& detour, std::vector<uint8_t>& longest, size_t limit) {
+  for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
+    uint16_t target = cboard.doMove(source, move);
+
+    if(target == end) {
+      if(detour.size() + 1 > longest.size() && !cboard.isConnectionCrossesEdge(source, move)) {
+        longest = detour;
+        longest.push_back(move);
+      }
+    }else if(detour.size() + 2 <= limit && !cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(source, move)) {
+      cboard.updateField(sourceMoves | move, source);
+      cboard.setField(cboard.rotate180(move), target);
+      detour.push_back(move);
+      this->route(cboard, target, cboard.rotate180(move), end, detour, longest, limit);
+      detour.pop_back();
+      cboard.unsetField(target);
+      cboard.updateField(sourceMoves, source);
+    }
+  }
+}
+
+/**
+  * @brief  Returns the fields of a closed path in order, starting at the root.
+  * @param  cboard The board of the closed path
+  * @param  moves  Returns the moves of the path, moves[i] leads from field i to the next one
+  * @retval The field indices of the path
+  */
+std::vector<uint16_t> BeamSearch::getPath(const Chessboard& cboard, std::vector<uint8_t>& moves) const {
+  std::vector<uint16_t> path;
+  moves.clear();
+
+  uint16_t root = cboard.getRootIndex();
+  uint16_t current = root;
+  uint8_t previous = 0;
+  do {
+    uint8_t next = 0;
+    for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
+      if((cboard.at(current) & move) != 0 && (previous == 0 || move != cboard.rotate180(previous))) {
+        next = move;
+        break;
+      }
+    }
+    path.push_back(current);
+    moves.push_back(next);
+    current = cboard.doMove(current, next);
+    previous = next;
+  } while(current != root && path.size() <= cboard.getLength());
+  return path;
+}
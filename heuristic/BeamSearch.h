@@ -0,0 +1,70 @@
+#ifndef BEAMSEARCH_H
+#define BEAMSEARCH_H
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#include "Chessboard.h"
+
+//A closed path is extended by the local search if it is at most this much shorter than the longest one so far
+#define EXTEND_SLACK 8
+//The longest path segment (in moves) that the local search replaces
+#define REROUTE_SEGMENT 4
+//The number of moves that a replacement may be longer than the segment it replaces
+#define REROUTE_DETOUR 6
+
+/**
+ * A randomized beam search for a long uncrossed closed path from one root. Ply by ply every kept partial path is
+ * extended by all valid moves, paths that can't return to the root anymore are dropped and the partial paths with
+ * the longest closed path of a greedy rollout (Warnsdorff's rule: the move with the fewest onward moves first) are
+ * kept. Every closed path of the beam or of a rollout is a candidate. Candidates close to the longest one are
+ * extended by a local search that replaces short segments of the path by longer detours over free fields.
+ * The random generator is a plain xorshift, so a seed gives the same path on every platform.
+ */
+class BeamSearch {
+
+private:
+	/**
+	 * Data class that stores a partial path of the beam: the board and the field the path ends on.
+	 */
+	class Node {
+	public:
+		Chessboard cboard;
+		uint16_t source;
+		uint8_t incoming_move;
+	};
+
+	/**
+	 * Data class that stores a valid extension of a partial path and its score.
+	 */
+	class Candidate {
+	public:
+		uint32_t parent;
+		uint8_t move;
+		double score;
+	};
+
+	uint16_t width;
+	double jitter;
+	uint64_t state;
+
+	Chessboard longestPath;
+
+	double nextRandom();
+	uint8_t countMoves(const Chessboard&, uint16_t) const;
+	uint16_t rollout(const Chessboard&, uint16_t, uint8_t);
+	void close(const Chessboard&, uint16_t, uint8_t, uint8_t);
+
+	void extend(Chessboard&);
+	bool reroute(Chessboard&, const std::vector<uint16_t>&, const std::vector<uint8_t>&, size_t, size_t);
+	void route(Chessboard&, uint16_t, uint8_t, uint16_t, std::vector<uint8_t>&, std::vector<uint8_t>&, size_t);
+	std::vector<uint16_t> getPath(const Chessboard&, std::vector<uint8_t>&) const;
+
+public:
+	BeamSearch(uint16_t, double, uint64_t);
+
+	Chessboard run(const Chessboard&, std::pair<uint8_t, uint8_t>);
+};
+
+#endif /* BEAMSEARCH_H */
@@ -0,0 +1,495 @@
+#include "Chessboard.h"
+
+#include <string.h>
+
+/**
+  * @brief  Default constructor
+  */
+Chessboard::Chessboard() : Chessboard(0, 0) { }
+
+/**
+  * @brief  Constructor of the chessboard
+  * @param  m width
+  * @param  n height
+  */
+Chessboard::Chessboard(uint8_t m, uint8_t n) 
+: width(m), height(n), totalWidth(m + 2*BORDER_OFFSET), totalHeight(n + 2*BORDER_OFFSET), matrix(nullptr), moveTable(MoveTable::forWidth(totalWidth)), length(0) {
+  selectStorage();
+  memset(this->matrix, 0b11111111, this->totalWidth * this->totalHeight);
+  setupFields();
+}
+
+/**
+  * @brief  Default destructor
+  */
+Chessboard::~Chessboard() {
+}
+
+/**
+  * @brief  Copy constructor. Boards that fit into the inline cells are copied without an allocation.
+  * @param  other The chessboard to copy
+  */
+Chessboard::Chessboard(const Chessboard& other)
+: width(other.width), height(other.height), totalWidth(other.totalWidth), totalHeight(other.totalHeight), matrix(nullptr),
+  moveTable(other.moveTable), root(other.root), rootIndex(other.rootIndex), length(other.length) {
+  selectStorage();
+  memcpy(this->matrix, other.matrix, this->totalWidth * this->totalHeight);
+}
+
+/**
+  * @brief  Copy assignment. Boards that fit into the inline cells are copied without an allocation.
+  * @param  other The chessboard to copy
+  * @retval This chessboard
+  */
+Chessboard& Chessboard::operator=(const Chessboard& other) {
+  if(this != &other) {
+    this->width = other.width;
+    this->height = other.height;
+    this->totalWidth = other.totalWidth;
+    this->totalHeight = other.totalHeight;
+    this->moveTable = other.moveTable;
+    this->root = other.root;
+    this->rootIndex = other.rootIndex;
+    this->length = other.length;
+    selectStorage();
+    memcpy(this->matrix, other.matrix, this->totalWidth * this->totalHeight);
+  }
+  return *this;
+}
+
+/**
+  * @brief  Selects the storage of the fields: the inline cells, or the overflow vector if the board is too large for them.
+  * @param  None
+  * @retval None
+  */
+void Chessboard::selectStorage() {
+  uint32_t fields = this->totalWidth * this->totalHeight;
+  if(fields <= CHESSBOARD_INLINE_FIELDS) {
+    this->overflow.clear();
+    this->matrix = this->cells;
+  }else{
+    this->overflow.resize(fields);
+    this->matrix = this->overflow.data();
+  }
+}
+
+/**
+  * @brief  Sets all fields with their moves as empty and sets the border to 0b11111111
+  * @param  None
+  * @retval None
+  */
+void Chessboard::setupFields() {
+	for(int y = 0; y < this->height; y++){
+    for(int x = 0; x < this->width; x++){
+      this->matrix[(y+ BORDER_OFFSET) * this->totalWidth + x + BORDER_OFFSET] = 0;
+    }
+  }
+}
+
+/**
+  * @brief  Returns value of area on chessboard
+  * @param  m x-position of chessboard
+  * @param  n y-position of chessboard
+  * @retval Moves in given position
+  */
+uint8_t Chessboard::at(uint8_t x, uint8_t y) const {
+  return this->matrix[y*this->totalWidth + x];
+}
+
+std::pair<uint8_t, uint8_t> Chessboard::getRoot() const{
+  return this->root;
+}
+
+/**
+  * @brief  Sets the moves to a field. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    getLength()
+  */
+void Chessboard::setField(uint8_t moves, std::pair<uint8_t, uint8_t> field) {
+  this->matrix[field.second*this->totalWidth + field.first] = moves;
+  this->length++;
+}
+
+/**
+  * @brief  A method to update a field of the chessboard. This doesn't alter the path length.
+  * @param  moves The moves to set
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    setField()
+  */
+void Chessboard::updateField(uint8_t moves, std::pair<uint8_t, uint8_t> field){
+  this->matrix[field.second*this->totalWidth + field.first] = moves;
+}
+
+/**
+  * @brief  Reverts a previous setField() call. Clears the moves of the field and decreases the path length by one.
+  *         Used by the in-place backtracking to restore the board when returning from a node.
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    setField()
+  */
+void Chessboard::unsetField(std::pair<uint8_t, uint8_t> field){
+  this->matrix[field.second*this->totalWidth + field.first] = 0b00000000;
+  this->length--;
+}
+
+/**
+  * @brief  Sets a field as root. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  _root The coordinates of the root
+  * @retval None
+  * @see    setField()
+  * @see    getLength()
+  */
+void Chessboard::setRoot(uint8_t moves, std::pair<uint8_t, uint8_t> _root){
+  this->root = _root;
+  this->rootIndex = toIndex(_root);
+  this->setField(moves, _root);
+}
+
+/**
+  * @brief  Returns the width of the chessboard.
+  * @param  None
+  * @retval width
+  */
+uint8_t Chessboard::getWidth() const {
+  return this->width;
+}
+
+/**
+  * @brief  Returns the hight of the chessboard.
+  * @param  None
+  * @retval height
+  */
+uint8_t Chessboard::getHeight() const {
+  return this->height;
+}
+
+/**
+  * @brief  Returns the width of the chessboard, including the borders.
+  * @param  None
+  * @retval total width
+  */
+uint16_t Chessboard::getTotalWidth() const {
+  return this->totalWidth;
+}
+
+/**
+  * @brief  Returns the height of the chessboard, including the borders.
+  * @param  None
+  * @retval total height
+  */
+uint16_t Chessboard::getTotalHeight() const {
+  return this->totalHeight;
+}
+
+/**
+  * @brief  Returns the move table of the chessboard with the flat index offsets for its width.
+  * @param  None
+  * @retval The move table
+  */
+const MoveTable* Chessboard::getMoveTable() const {
+  return this->moveTable;
+}
+
+/**
+  * @brief  Returns the current paths length.
+  * @param  None
+  * @retval The length of the current path
+  */
+uint16_t Chessboard::getLength() const {
+  return this->length;
+}
+
+/**
+  * @brief  Prints the current chessboard to the console.
+  * @param  None
+  * @retval None
+  */
+void Chessboard::debug() const {
+  std::cout << "Board [" << (int) this->getWidth() << "x" << (int) this->getHeight() << " | " << this->getLength() << "]" << std::endl;
+  for(uint8_t y = 0; y<this->getHeight(); y++) {
+    for(uint8_t x = 0; x < this->getWidth(); x++){
+      if(!this->at(x+ BORDER_OFFSET, y+BORDER_OFFSET)){
+        std::cout << "0        ";
+      }else{
+          std::cout << std::bitset<8>(this->at(x+BORDER_OFFSET, y+ BORDER_OFFSET)) << " ";
+      }
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+/**
+  * @brief  Returns the target of a move from the knight. Does not alter the chessboard.
+  * @param  source  The current field of the knight
+  * @param  move    The move of the knight in the bit format (exactly one bit set)
+  * @retval The target node position
+  */
+std::pair<uint8_t, uint8_t> Chessboard::doMove(std::pair<uint8_t, uint8_t> source, uint8_t move) const{
+  uint8_t i = MoveTable::index(move);
+  return std::make_pair(source.first + MoveTable::moveDx[i], source.second + MoveTable::moveDy[i]);
+}
+
+/**
+  * @brief  Rotates the move by 180 degrees.
+  * @param  move The move represented in the bit format
+  * @retval The rotated move in the bit format
+  */
+uint8_t Chessboard::rotate180(uint8_t move) const{
+    return (move << 4) | (move >> 4);   
+}
+
+/**
+  * @brief  Checks if the given move finishes the path. Checks that the move isn't backwards.
+  * @param  source        The start position of the move
+  * @param  target        The target position of the move
+  * @param  outgoing_move The move represented in the bit format
+  * @retval true:   Node can be processed further
+  *         false:  Node cannot be processed further
+  */
+bool Chessboard::isFinishable(std::pair<uint8_t, uint8_t> source, std::pair<uint8_t, uint8_t> target, uint8_t outgoing_move) const{
+  return (target.first == root.first && target.second == root.second)
+		  && !(source.first == root.first && source.second == root.second)
+		  && !isConnectionCrossesEdge(source, outgoing_move);
+}
+
+/**
+  * @brief  Checks whether a field is already a part of the path.
+  * @param  field   The position of the field to check
+  * @retval true:   Node is currently not a part of the path
+  *         false:  Node is already a part of the path
+  */
+bool Chessboard::isFieldReserved(std::pair<uint8_t, uint8_t> field) const{
+  return at(field.first, field.second) != 0b00000000;
+}
+
+/**
+  * @brief  Checks whether a field contains a given knight move, which means that it is connected to the target field of that move.
+  * Border fields are never treated as a connection.
+  * @param  x The x coordinate of the field to check
+  * @param  y The y coordinate fo the filed to check
+  * @retval true:   Node is connected with that move
+  *         false:  Node is not connected with that move
+  */
+bool Chessboard::isCandidateConnected(uint8_t x, uint8_t y, uint8_t moves) const {
+  uint8_t candidate = at(x, y);
+  if (candidate != 0b11111111) {
+    return (candidate & moves) != 0b00000000;
+  }
+  else return false;
+}
+
+/**
+  * @brief  Checks if the edge to the node crosses another edge.
+  * @param  source  The position of the node to check
+  * @param  moves   The edge to check a possible crossing with (exactly one bit set)
+  * @retval true:   The move crosses an existing connection
+  *         false:  The move doesn't cross an existing connection
+  * @see    isConnectionCrossesEdge(uint16_t, uint8_t)
+  */
+bool Chessboard::isConnectionCrossesEdge(std::pair<uint8_t, uint8_t> source, uint8_t moves) const {
+  return isConnectionCrossesEdge(toIndex(source), moves);
+}
+
+/**
+  * @brief  Converts a position to its flat field index.
+  * @param  field The position of the field (including the border offset)
+  * @retval The field index
+  */
+uint16_t Chessboard::toIndex(std::pair<uint8_t, uint8_t> field) const {
+  return field.second * this->totalWidth + field.first;
+}
+
+/**
+  * @brief  Converts a flat field index back to its position, e.g. for exporting or debugging.
+  * @param  index The field index
+  * @retval The position of the field (including the border offset)
+  */
+std::pair<uint8_t, uint8_t> Chessboard::toField(uint16_t index) const {
+  return std::make_pair(index % this->totalWidth, index / this->totalWidth);
+}
+
+/**
+  * @brief  Returns the field index of the root.
+  * @param  None
+  * @retval The field index of the root
+  */
+uint16_t Chessboard::getRootIndex() const {
+  return this->rootIndex;
+}
+
+/**
+  * @brief  Returns the moves of a field.
+  * @param  index The field index
+  * @retval Moves in given field
+  */
+uint8_t Chessboard::at(uint16_t index) const {
+  return this->matrix[index];
+}
+
+/**
+  * @brief  Sets the moves to a field. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  index The field index
+  * @retval None
+  */
+void Chessboard::setField(uint8_t moves, uint16_t index) {
+  this->matrix[index] = moves;
+  this->length++;
+}
+
+/**
+  * @brief  Updates the moves of a field. This doesn't alter the path length.
+  * @param  moves The moves to set
+  * @param  index The field index
+  * @retval None
+  */
+void Chessboard::updateField(uint8_t moves, uint16_t index) {
+  this->matrix[index] = moves;
+}
+
+/**
+  * @brief  Reverts a previous setField() call. Clears the moves of the field and decreases the path length by one.
+  * @param  index The field index
+  * @retval None
+  */
+void Chessboard::unsetField(uint16_t index) {
+  this->matrix[index] = 0b00000000;
+  this->length--;
+}
+
+/**
+  * @brief  Blocks all free fields with a smaller field index than the given one. Blocked fields are treated like
+  *         border fields, so they are neither free nor a connection. This doesn't alter the path length.
+  * @param  index The field index of the first field that stays free
+  * @retval None
+  */
+void Chessboard::blockFieldsBefore(uint16_t index) {
+  for(uint16_t i = 0; i < index; i++) {
+    if(this->matrix[i] == 0b00000000) { this->matrix[i] = 0b11111111; }
+  }
+}
+
+/**
+  * @brief  Returns the target of a move from the knight. The move is a constant index delta from the move table.
+  *         Moves over the edge of the board end in a border field.
+  * @param  source  The field index of the knight
+  * @param  move    The move of the knight in the bit format (exactly one bit set)
+  * @retval The field index of the target
+  */
+uint16_t Chessboard::doMove(uint16_t source, uint8_t move) const {
+  return source + this->moveTable->moveOffset[MoveTable::index(move)];
+}
+
+/**
+  * @brief  Checks if the given move finishes the path. Checks that the move isn't backwards.
+  * @param  source        The field index of the start of the move
+  * @param  target        The field index of the target of the move
+  * @param  outgoing_move The move represented in the bit format
+  * @retval true:   The move closes the path
+  *         false:  The move doesn't close the path
+  */
+bool Chessboard::isFinishable(uint16_t source, uint16_t target, uint8_t outgoing_move) const {
+  return target == this->rootIndex && source != this->rootIndex && !isConnectionCrossesEdge(source, outgoing_move);
+}
+
+/**
+  * @brief  Checks whether a field is already a part of the path. Border fields are always reserved.
+  * @param  index   The field index
+  * @retval true:   Node is already a part of the path or a border field
+  *         false:  Node is currently not a part of the path
+  */
+bool Chessboard::isFieldReserved(uint16_t index) const {
+  return this->matrix[index] != 0b00000000;
+}
+
+/**
+  * @brief  Checks if the edge to the node crosses another edge. The four relevant neighbours of the move (see figure 5)
+  *         and the moves that would cross it are taken from the move table, so no case distinction is needed.
+  *         Border fields are never treated as a connection.
+  * @param  source  The field index of the node to check
+  * @param  moves   The edge to check a possible crossing with (exactly one bit set)
+  * @retval true:   The move crosses an existing connection
+  *         false:  The move doesn't cross an existing connection
+  */
+bool Chessboard::isConnectionCrossesEdge(uint16_t source, uint8_t moves) const {
+  uint8_t i = MoveTable::index(moves);
+  const uint8_t* field = &this->matrix[source];
+  const int16_t* offsets = this->moveTable->neighbourOffset[i];
+  const uint8_t* masks = MoveTable::neighbourMask[i];
+
+  uint8_t conflicts = 0;
+  for(uint8_t k = 0; k < NEIGHBOUR_COUNT; k++) {
+    uint8_t candidate = field[offsets[k]];
+    conflicts |= (candidate & masks[k]) & (uint8_t) -(candidate != 0b11111111);
+  }
+  return conflicts != 0;
+}
+
+/**
+  * @brief  Counts the free fields that the knight can reach from a field over free fields, the field itself included.
+  *         Crossings are ignored, so the path can't visit more fields from here. This is used as upper bound for pruning.
+  *         The search stops as soon as limit fields are found. The buffers are kept per thread, so there is no allocation per call.
+  * @param  source  The field index to start from
+  * @param  limit   The number of fields after which the counting stops
+  * @retval The number of reachable free fields, at most limit
+  */
+uint16_t Chessboard::countReachable(uint16_t source, uint16_t limit) const {
+  static thread_local std::vector<uint16_t> queue;
+  static thread_local std::vector<uint8_t> visited;
+  size_t fields = this->totalWidth * this->totalHeight;
+  if(visited.size() < fields) { visited.resize(fields, 0); }
+
+  queue.clear();
+  queue.push_back(source);
+  visited[source] = 1;
+  for(size_t q = 0; q < queue.size() && queue.size() < limit; q++) {
+    for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+      uint16_t target = queue[q] + this->moveTable->moveOffset[i];
+      if(this->matrix[target] == 0b00000000 && !visited[target]) {
+        visited[target] = 1;
+        queue.push_back(target);
+      }
+    }
+  }
+
+  for(uint16_t index : queue) { visited[index] = 0; }
+  return queue.size() < limit ? queue.size() : limit;
+}
+
+/**
+  * @brief  Checks whether the path can still be closed: the root needs to be a knight move away from source
+  *         or from a free field that the knight can reach from source over free fields. Crossings are ignored,
+  *         so a path that fails this check can never be closed. The search stops as soon as the root is found.
+  * @param  source  The field index to start from
+  * @retval true:   The root can be reached
+  *         false:  The root can't be reached anymore
+  */
+bool Chessboard::isRootReachable(uint16_t source) const {
+  static thread_local std::vector<uint16_t> queue;
+  static thread_local std::vector<uint8_t> visited;
+  size_t fields = this->totalWidth * this->totalHeight;
+  if(visited.size() < fields) { visited.resize(fields, 0); }
+
+  bool found = false;
+  queue.clear();
+  queue.push_back(source);
+  visited[source] = 1;
+  for(size_t q = 0; q < queue.size() && !found; q++) {
+    for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+      uint16_t target = queue[q] + this->moveTable->moveOffset[i];
+      found |= (target == this->rootIndex);
+      if(this->matrix[target] == 0b00000000 && !visited[target]) {
+        visited[target] = 1;
+        queue.push_back(target);
+      }
+    }
+  }
+
+  for(uint16_t index : queue) { visited[index] = 0; }
+  return found;
+}
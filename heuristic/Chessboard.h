@@ -0,0 +1,89 @@
+#ifndef CHESSBOARD_H
+#define CHESSBOARD_H
+
+#include <vector>
+#include <bitset>
+#include <iostream>
+
+#include "MoveTable.h"
+
+#define BORDER_OFFSET 2
+
+//Boards with up to 256 fields including the border (12x12) keep their fields inline, so a copy doesn't allocate
+#define CHESSBOARD_INLINE_FIELDS 256
+
+class Chessboard {
+    private:   
+        uint8_t width;
+        uint8_t height;
+
+        uint16_t totalWidth;
+        uint16_t totalHeight;
+        
+        //The fields are stored in cells, larger boards use the overflow vector. matrix points to the used one.
+        uint8_t cells[CHESSBOARD_INLINE_FIELDS];
+        std::vector<uint8_t> overflow;
+        uint8_t* matrix;
+        const MoveTable* moveTable;
+        std::pair<uint8_t, uint8_t> root;
+        uint16_t rootIndex = 0;
+
+        uint16_t length = 0;
+        void selectStorage();
+        void setupFields();
+
+    public:
+        Chessboard();
+        Chessboard(uint8_t, uint8_t);
+        Chessboard(const Chessboard&);
+        Chessboard& operator=(const Chessboard&);
+        virtual ~Chessboard();
+
+        void setField(uint8_t, std::pair<uint8_t, uint8_t>);
+        void updateField(uint8_t, std::pair<uint8_t, uint8_t>);
+        void unsetField(std::pair<uint8_t, uint8_t>);
+        void setRoot(uint8_t, std::pair<uint8_t, uint8_t>);
+
+        uint8_t at(uint8_t, uint8_t) const;
+        std::pair<uint8_t, uint8_t> getRoot() const;
+
+        uint8_t getWidth() const;
+        uint8_t getHeight() const;
+        uint16_t getLength() const;
+
+        uint16_t getTotalWidth() const;
+        uint16_t getTotalHeight() const;
+        const MoveTable* getMoveTable() const;
+
+        void debug() const;
+
+        //Moves
+        std::pair<uint8_t, uint8_t> doMove(std::pair<uint8_t, uint8_t>, uint8_t) const;
+        uint8_t rotate180(uint8_t) const;
+
+        //Field checking
+        bool isFinishable(std::pair<uint8_t, uint8_t>, std::pair<uint8_t, uint8_t>, uint8_t) const;
+        bool isFieldReserved(std::pair<uint8_t, uint8_t>) const;
+        bool isCandidateConnected(uint8_t , uint8_t, uint8_t) const;
+        bool isConnectionCrossesEdge(std::pair<uint8_t, uint8_t>, uint8_t) const;
+
+        //Flat field index (y * totalWidth + x). Used by the backtracking instead of positions.
+        uint16_t toIndex(std::pair<uint8_t, uint8_t>) const;
+        std::pair<uint8_t, uint8_t> toField(uint16_t) const;
+        uint16_t getRootIndex() const;
+
+        uint8_t at(uint16_t) const;
+        void setField(uint8_t, uint16_t);
+        void updateField(uint8_t, uint16_t);
+        void unsetField(uint16_t);
+        void blockFieldsBefore(uint16_t);
+
+        uint16_t doMove(uint16_t, uint8_t) const;
+        bool isFinishable(uint16_t, uint16_t, uint8_t) const;
+        bool isFieldReserved(uint16_t) const;
+        bool isConnectionCrossesEdge(uint16_t, uint8_t) const;
+        uint16_t countReachable(uint16_t, uint16_t) const;
+        bool isRootReachable(uint16_t) const;
+};
+
+#endif /* CHESSBOARD_H */
\ No newline at end of file
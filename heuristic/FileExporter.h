@@ -0,0 +1,23 @@
+#ifndef FILEEXPORTER_H
+#define FILEEXPORTER_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+
+#include "Chessboard.h"
+
+class FileExporter
+{
+private:
+    uint8_t getRootMove(uint8_t);
+    uint8_t getNextMove(Chessboard&, uint8_t, uint8_t);
+    void writePath(Chessboard &, std::ofstream &);
+
+public:
+    void exportPath(Chessboard &, int);
+    void exportHeuristicPath(Chessboard &);
+};
+
+#endif /* FILEEXPORTER_H */
\ No newline at end of file
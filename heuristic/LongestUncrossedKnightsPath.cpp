@@ -0,0 +1,89 @@
+#include "LongestUncrossedKnightsPath.h"
+
+/**
+  * @brief  Constructor of algorithm
+  * @param  m	width of the chessboard
+  * @param  n 	height of the chessboard
+  * @retval None
+  */
+LongestUncrossedKnightsPath::LongestUncrossedKnightsPath(uint8_t m, uint8_t n) :chessboard(m, n) {}
+
+/**
+  * @brief  Default destructor
+  */
+LongestUncrossedKnightsPath::~LongestUncrossedKnightsPath() {}
+
+void LongestUncrossedKnightsPath::setThreadLimit(uint16_t threads){
+	this->n_thread_limit = threads;
+}
+
+/**
+  * @brief  Sets the options that select how the heuristic search is executed.
+  * @param  _options The search options
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::setSearchOptions(const SearchOptions& _options){
+	this->options = _options;
+}
+
+/**
+  * @brief  Returns the roots of the beam searches: the fields of the lower left quadrant. Every closed path
+  *         has a symmetric copy that visits this quadrant, so no other fields are needed as roots.
+  * @retval The roots, with the border offset
+  */
+std::vector<std::pair<uint8_t, uint8_t>> LongestUncrossedKnightsPath::getRoots() const{
+	std::vector<std::pair<uint8_t, uint8_t>> roots;
+	for(uint8_t y = 0; y < (this->chessboard.getHeight() + 1) / 2; y++){
+		for(uint8_t x = 0; x < (this->chessboard.getWidth() + 1) / 2; x++){
+			roots.push_back(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+		}
+	}
+	return roots;
+}
+
+/**
+  * @brief  Runs all beam searches in parallel. Restart i uses root i modulo the number of roots and the seed
+  *         of the options plus i. The longest path wins, on equal lengths the one of the smaller restart, so the
+  *         result doesn't depend on the number of threads or the order in which the restarts finish.
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::run(){
+	tbb::task_scheduler_init init(this->n_thread_limit > 0 ? this->n_thread_limit : tbb::task_scheduler_init::automatic);
+
+	std::vector<std::pair<uint8_t, uint8_t>> roots = this->getRoots();
+	std::vector<Chessboard> results(this->options.restarts);
+	tbb::parallel_for(tbb::blocked_range<uint32_t>(0, this->options.restarts, 1), [&](const tbb::blocked_range<uint32_t>& range){
+		for(uint32_t i = range.begin(); i != range.end(); i++){
+			BeamSearch search(this->options.beamWidth, this->options.jitter, this->options.seed + i);
+			results[i] = search.run(this->chessboard, roots[i % roots.size()]);
+		}
+	});
+
+	this->longestPathLength = 0;
+	for(uint32_t i = 0; i < results.size(); i++){
+		if(results[i].getLength() > this->longestPathLength){
+			this->longestPathLength = results[i].getLength();
+			this->longestPathRestart = i;
+			this->longestPathBoard = results[i];
+		}
+	}
+}
+
+/**
+  * @brief  Prints the longest path found and writes it to paths/MxN_heuristic.path.
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::exportLongestPath(){
+	if(this->longestPathLength == 0){
+		std::cout << "No path was found." << std::endl;
+		return;
+	}
+
+	std::pair<uint8_t, uint8_t> root = this->longestPathBoard.getRoot();
+	std::cout << "Longest path found: " << this->longestPathLength << " (restart " << this->longestPathRestart << ", root ("
+		<< (int) root.first - BORDER_OFFSET << ", " << (int) root.second - BORDER_OFFSET << "))." << std::endl;
+	std::cout << "It is a lower bound for the exact engines: --lower-bound " << this->longestPathLength << std::endl;
+
+	FileExporter exporter;
+	exporter.exportHeuristicPath(this->longestPathBoard);
+}
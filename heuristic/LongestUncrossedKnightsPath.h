@@ -0,0 +1,41 @@
+#ifndef LONGESTUNCROSSEDKNIGHTSPATH_H
+#define LONGESTUNCROSSEDKNIGHTSPATH_H
+
+#include <iostream>
+#include <stdint.h>
+#include <vector>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/task_scheduler_init.h"
+
+#include "Chessboard.h"
+#include "BeamSearch.h"
+#include "SearchOptions.h"
+#include "FileExporter.h"
+
+class LongestUncrossedKnightsPath {
+
+private:
+	uint16_t n_thread_limit = 0;
+
+	Chessboard chessboard;
+	SearchOptions options;
+
+	std::vector<std::pair<uint8_t, uint8_t>> getRoots() const;
+
+public:
+	uint16_t longestPathLength = 0;
+	uint32_t longestPathRestart = 0;
+	Chessboard longestPathBoard;
+
+	LongestUncrossedKnightsPath(uint8_t, uint8_t);
+	virtual ~LongestUncrossedKnightsPath();
+
+	void setThreadLimit(uint16_t);
+	void setSearchOptions(const SearchOptions&);
+	void run();
+	void exportLongestPath();
+};
+
+#endif /* LONGESTUNCROSSEDKNIGHTSPATH_H */
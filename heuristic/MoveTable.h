@@ -0,0 +1,66 @@
+#ifndef MOVETABLE_H
+#define MOVETABLE_H
+
+#include <stdint.h>
+
+#define MOVE_COUNT 8
+#define NEIGHBOUR_COUNT 4
+
+/**
+ * Precomputed move data for a board width. A move in the bit format 1 << i has the index i.
+ * For each move it contains the field offset of the target and the four neighbours that need to be checked
+ * for a crossing, together with the moves of these neighbours that would cross the move (see figure 5).
+ * The offsets are flat index deltas for a row length of totalWidth. The tables are shared by all boards of the same width.
+ */
+class MoveTable {
+public:
+	//Position deltas of the target and of the relevant neighbours of each move
+	static constexpr int8_t moveDx[MOVE_COUNT] = { 1,  2,  2,  1, -1, -2, -2, -1};
+	static constexpr int8_t moveDy[MOVE_COUNT] = { 2,  1, -1, -2, -2, -1,  1,  2};
+
+	//The colors refer to the cases in figure 5: orange, blue, green, purple
+	static constexpr int8_t neighbourDx[MOVE_COUNT][NEIGHBOUR_COUNT] = {
+		{ 0,  1,  1,  0},
+		{ 1,  1,  0,  2},
+		{ 1,  1,  0,  2},
+		{ 1,  0,  1,  0},
+		{ 0, -1, -1,  0},
+		{-1, -1,  0, -2},
+		{-1, -1,  0, -2},
+		{-1,  0, -1,  0}
+	};
+	static constexpr int8_t neighbourDy[MOVE_COUNT][NEIGHBOUR_COUNT] = {
+		{ 1,  1,  0,  2},
+		{ 1,  0,  1,  0},
+		{ 0, -1, -1,  0},
+		{-1, -1,  0, -2},
+		{-1, -1,  0, -2},
+		{-1,  0, -1,  0},
+		{ 0,  1,  1,  0},
+		{ 1,  1,  0,  2}
+	};
+
+	//The moves of a neighbour that cross the move
+	static constexpr uint8_t neighbourMask[MOVE_COUNT][NEIGHBOUR_COUNT] = {
+		{0b00001110, 0b11100000, 0b01000000, 0b00001100},
+		{0b00011100, 0b11000001, 0b00001000, 0b11000000},
+		{0b00111000, 0b10000011, 0b00000001, 0b00110000},
+		{0b01110000, 0b00000111, 0b00100000, 0b00000011},
+		{0b11100000, 0b00001110, 0b00000100, 0b11000000},
+		{0b11000001, 0b00011100, 0b10000000, 0b00001100},
+		{0b10000011, 0b00111000, 0b00010000, 0b00000011},
+		{0b00000111, 0b01110000, 0b00000010, 0b00110000}
+	};
+
+	//Flat index deltas for the row length of this table
+	int16_t moveOffset[MOVE_COUNT];
+	int16_t neighbourOffset[MOVE_COUNT][NEIGHBOUR_COUNT];
+
+	static const MoveTable* forWidth(uint16_t);
+	static inline uint8_t index(uint8_t move) { return __builtin_ctz(move); }
+
+private:
+	explicit MoveTable(uint16_t);
+};
+
+#endif /* MOVETABLE_H */
@@ -0,0 +1,26 @@
+#ifndef SEARCHOPTIONS_H
+#define SEARCHOPTIONS_H
+
+#include "stdint.h"
+
+/**
+ * Data class that stores the options that select how the heuristic search is executed.
+ */
+class SearchOptions {
+public:
+	//w > 0: The number of partial paths that are kept per ply of a beam search
+	uint16_t beamWidth = 64;
+
+	//i > 0: The number of independent beam searches. The roots are taken in turn from the start fields
+	//       of one quadrant of the board, every search has its own random generator
+	uint32_t restarts = 64;
+
+	//The seed of the random generators. The same seed gives the same path, independent of the number of threads
+	uint64_t seed = 1;
+
+	//j >= 0: The maximal random value that is added to the score of a partial path, so equal partial paths are kept in varying order
+	//0:      The beam search is deterministic for every root and all restarts of a root give the same path
+	double jitter = 2.0;
+};
+
+#endif /* SEARCHOPTIONS_H */
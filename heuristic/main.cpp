@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+#include "LongestUncrossedKnightsPath.h"
+
+bool get_args(int, char*[], uint8_t&, uint8_t&, uint16_t&, SearchOptions&);
+
+void err_abort (const char*);
+
+int main(int argc, char* argv[]) {
+
+    uint8_t m = 0, n = 0;
+    uint16_t t = 0;
+    SearchOptions options;
+    if(!get_args(argc, argv, m, n, t, options)){
+        err_abort("Valid are: \nWith all threads: -m 16 -n 16\nWith limited threads: -m 16 -n 16 -t 1\nOptional: -w 64 (keep 64 partial paths per ply of a beam search)\n          -i 64 (run 64 beam searches, the roots are taken in turn from one quadrant)\n          --seed 1 (the seed of the random generators, the same seed gives the same path)\n          -j 2 (add a random value up to 2 to the score of a partial path, 0 makes every root deterministic)");
+    }
+    if((m < 4 || n < 4) &&  (m + n) < 8){
+        err_abort("Calculation only works from boards with min size 5x3 or 4x4");
+    }
+
+    auto start = std::chrono::system_clock::now();
+
+    std::cout << "Running " << options.restarts << " beam searches of width " << options.beamWidth << " on a " << (int) m << "x" << (int) n << " board with " << (int) (t > 0 ? t: std::thread::hardware_concurrency()) << " threads." << std::endl;
+    LongestUncrossedKnightsPath algorithmn(m, n);
+    algorithmn.setThreadLimit(t);
+    algorithmn.setSearchOptions(options);
+    algorithmn.run();
+
+    auto end = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end-start;
+
+    std::cout << "Elapsed time: " << elapsed_seconds.count() << " seconds." << std::endl;
+    algorithmn.exportLongestPath();
+}
+
+/**
+  * @brief  Parses the command line arguments. Options with a value are given as pairs (-m 8).
+  * @retval true:   The arguments are valid
+  *         false:  An argument is unknown, the board size is missing or a search would do nothing
+  */
+bool get_args(int argc, char *argv[], uint8_t &m, uint8_t &n, uint16_t& t, SearchOptions& options) {
+    for(int i=1; i<argc; i++) {
+        bool hasValue = (i+1 < argc);
+        if(strcmp(argv[i], "-m") == 0 && hasValue) {
+            m = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-n") == 0 && hasValue) {
+            n = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-t") == 0 && hasValue) {
+            t = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-w") == 0 && hasValue) {
+            options.beamWidth = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-i") == 0 && hasValue) {
+            options.restarts = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = strtoull(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-j") == 0 && hasValue) {
+            options.jitter = strtod(argv[++i], NULL);
+        } else {
+            return false;
+        }
+    }
+    return m > 0 && n > 0 && options.beamWidth > 0 && options.restarts > 0;
+}
+
+void err_abort (const char *str){
+	fprintf (stderr,"LongestUncrossedKnightsPath: %s\n", str);
+	fflush (stdout);
+	fflush (stderr);
+	exit (1);
+}
@@ -0,0 +1,92 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+#include <bitset>
+#include <iostream>
+
+#include "Chessboard.h"
+
+#define BITBOARD_MAX_FIELDS 64
+#define BITBOARD_OFF_BOARD 64
+
+/**
+ * Chessboard representation for boards with at most 64 fields. It provides the same interface as the Chessboard,
+ * so the backtracking can run on both. Instead of one byte per field, it stores one occupancy bitboard and one bitboard
+ * per move direction (bit i of edges[d] is set if field i contains the move 1 << d). Fields are numbered row by row
+ * without a border, moves that leave the board end in the index BITBOARD_OFF_BOARD. Positions are passed with the border
+ * offset, just like for the Chessboard.
+ */
+class Bitboard {
+    private:
+        uint8_t width;
+        uint8_t height;
+
+        uint64_t occupied = 0;
+        uint64_t edges[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        const uint64_t* crossing;
+        const uint8_t* targets;
+        const uint64_t* onBoard;
+
+        std::pair<uint8_t, uint8_t> root;
+        uint16_t rootIndex = BITBOARD_OFF_BOARD;
+        uint16_t length = 0;
+
+        uint8_t index(std::pair<uint8_t, uint8_t>) const;
+        bool isOnBoard(std::pair<uint8_t, uint8_t>) const;
+
+        static const uint64_t* getCrossingTable(uint8_t);
+        static const uint8_t* getTargetTable(uint8_t, uint8_t);
+        static const uint64_t* getOnBoardTable(uint8_t, uint8_t);
+
+    public:
+        Bitboard();
+        Bitboard(uint8_t, uint8_t);
+        explicit Bitboard(const Chessboard&);
+
+        static bool fits(uint8_t, uint8_t);
+        explicit operator Chessboard() const;
+
+        void setField(uint8_t, std::pair<uint8_t, uint8_t>);
+        void updateField(uint8_t, std::pair<uint8_t, uint8_t>);
+        void unsetField(std::pair<uint8_t, uint8_t>);
+        void setRoot(uint8_t, std::pair<uint8_t, uint8_t>);
+
+        uint8_t at(uint8_t, uint8_t) const;
+        std::pair<uint8_t, uint8_t> getRoot() const;
+
+        uint8_t getWidth() const;
+        uint8_t getHeight() const;
+        uint16_t getLength() const;
+
+        void debug() const;
+
+        //Moves
+        std::pair<uint8_t, uint8_t> doMove(std::pair<uint8_t, uint8_t>, uint8_t) const;
+        uint8_t rotate180(uint8_t) const;
+
+        //Field checking
+        bool isFinishable(std::pair<uint8_t, uint8_t>, std::pair<uint8_t, uint8_t>, uint8_t) const;
+        bool isFieldReserved(std::pair<uint8_t, uint8_t>) const;
+        bool isConnectionCrossesEdge(std::pair<uint8_t, uint8_t>, uint8_t) const;
+
+        //Flat field index (bit index y * width + x, BITBOARD_OFF_BOARD for positions outside of the board)
+        uint16_t toIndex(std::pair<uint8_t, uint8_t>) const;
+        std::pair<uint8_t, uint8_t> toField(uint16_t) const;
+        uint16_t getRootIndex() const;
+
+        uint8_t at(uint16_t) const;
+        void setField(uint8_t, uint16_t);
+        void updateField(uint8_t, uint16_t);
+        void unsetField(uint16_t);
+
+        uint16_t doMove(uint16_t, uint8_t) const;
+        bool isFinishable(uint16_t, uint16_t, uint8_t) const;
+        bool isFieldReserved(uint16_t) const;
+        bool isConnectionCrossesEdge(uint16_t, uint8_t) const;
+        uint8_t getOpenMoves(uint16_t) const;
+        uint16_t countReachable(uint16_t, uint16_t) const;
+        bool isRootReachable(uint16_t) const;
+};
+
+#endif /* BITBOARD_H */
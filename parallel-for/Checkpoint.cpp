@@ -0,0 +1,129 @@
+#include "Checkpoint.h"
+
+/**
+  * @brief  Constructor of the checkpoint of a board size. The file is stored next to the paths.
+  * @param  cboard The chessboard of the run
+  * @param  suffix An additional part of the file name, so the shards of a board size don't share a checkpoint
+  */
+Checkpoint::Checkpoint(Chessboard& cboard, const std::string& suffix) {
+  this->filename = "./paths/" + std::to_string(cboard.getWidth()) + "x" + std::to_string(cboard.getHeight()) + suffix + ".checkpoint";
+}
+
+/**
+  * @brief  Destructor, stops the background thread if it is still running.
+  */
+Checkpoint::~Checkpoint() {
+  this->stop();
+}
+
+/**
+  * @brief  Writes the checkpoint. The results of the finished start configurations are merged with the base results.
+  *         The file is written to a temporary file first and renamed, so a crash while writing keeps the previous checkpoint.
+  * @param  input    The start configurations of the run
+  * @param  finished The flags of the finished start configurations
+  * @param  output   The outputs of the start configurations, only the finished ones are read
+  * @param  base     The results that were known before the run (start optimization or resumed checkpoint)
+  * @param  seconds  The elapsed time of the search so far
+  * @retval None
+  */
+void Checkpoint::save(const std::vector<ThreadInputData>& input, const std::vector<std::atomic<bool>>& finished, const std::vector<OutputData>& output, const OutputData& base, double seconds) const {
+  //The flags are read once, so the units and the merged results match
+  std::vector<bool> done(input.size());
+  OutputData result = base;
+  for(size_t i = 0; i < input.size(); i++) {
+    done[i] = finished[i];
+    if(done[i]) result += output[i];
+  }
+
+  std::string temporary = this->filename + ".tmp";
+  std::ofstream file(temporary);
+  file << "seconds " << seconds << std::endl;
+  file << "result ";
+  LUKPSerializer::writeOutput(file, result);
+  file << std::endl;
+
+  file << "units " << input.size() << std::endl;
+  for(size_t i = 0; i < input.size(); i++) {
+    file << (done[i] ? 1 : 0) << " ";
+    LUKPSerializer::writeInput(file, input[i]);
+    file << std::endl;
+  }
+  file.close();
+
+  std::rename(temporary.c_str(), this->filename.c_str());
+}
+
+/**
+  * @brief  Reads the checkpoint. Only the pending start configurations are returned, the results of the finished ones are in the base results.
+  * @param  pending  The pending start configurations
+  * @param  base     The merged results of the finished start configurations
+  * @param  seconds  The elapsed time of the search so far
+  * @retval true:   The checkpoint was read
+  *         false:  There is no checkpoint for the board size
+  */
+bool Checkpoint::load(std::vector<ThreadInputData>& pending, OutputData& base, double& seconds) const {
+  std::ifstream file(this->filename);
+  if(!file.is_open()) {
+    return false;
+  }
+
+  std::string key;
+  file >> key >> seconds;
+  file >> key;
+  base = LUKPSerializer::readOutput(file);
+
+  size_t units = 0;
+  file >> key >> units;
+  for(size_t i = 0; i < units; i++) {
+    int done = 0;
+    file >> done;
+    ThreadInputData data = LUKPSerializer::readInput(file);
+    if(!done) pending.push_back(data);
+  }
+  return !file.fail();
+}
+
+/**
+  * @brief  Removes the checkpoint, it is called when the search is complete.
+  * @retval None
+  */
+void Checkpoint::remove() const {
+  std::remove(this->filename.c_str());
+}
+
+/**
+  * @brief  Starts the background thread that writes the checkpoint periodically.
+  * @param  interval The time between two checkpoints in seconds
+  * @param  input    The start configurations of the run
+  * @param  finished The flags of the finished start configurations
+  * @param  output   The outputs of the start configurations
+  * @param  base     The results that were known before the run
+  * @param  previous The elapsed time of the previous runs
+  * @retval None
+  */
+void Checkpoint::start(uint32_t interval, const std::vector<ThreadInputData>& input, const std::vector<std::atomic<bool>>& finished, const std::vector<OutputData>& output, const OutputData& base, double previous) {
+  this->running = true;
+  this->writer = std::thread([this, interval, &input, &finished, &output, &base, previous]() {
+    auto begin = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while(!this->stopped.wait_for(lock, std::chrono::seconds(interval), [this]() { return !this->running; })) {
+      std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - begin;
+      this->save(input, finished, output, base, previous + elapsed_seconds.count());
+    }
+  });
+}
+
+/**
+  * @brief  Stops the background thread.
+  * @retval None
+  */
+void Checkpoint::stop() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->running = false;
+  }
+  this->stopped.notify_all();
+  if(this->writer.joinable()) {
+    this->writer.join();
+  }
+}
@@ -0,0 +1,48 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "stdint.h"
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "Chessboard.h"
+#include "LUKPData.h"
+#include "LUKPSerializer.h"
+
+/**
+ * Stores the progress of a run in a file, so a long search can be resumed after it was stopped.
+ * The file contains all start configurations with a flag whether they are finished, the merged results of the finished
+ * ones and the elapsed time. Start configurations that were running when the file was written are pending and get repeated.
+ * The file is written periodically by a background thread and replaced atomically.
+ */
+class Checkpoint {
+
+private:
+	std::string filename;
+
+	std::thread writer;
+	std::mutex mutex;
+	std::condition_variable stopped;
+	bool running = false;
+
+public:
+	Checkpoint(Chessboard&, const std::string&);
+	virtual ~Checkpoint();
+
+	void save(const std::vector<ThreadInputData>&, const std::vector<std::atomic<bool>>&, const std::vector<OutputData>&, const OutputData&, double) const;
+	bool load(std::vector<ThreadInputData>&, OutputData&, double&) const;
+	void remove() const;
+
+	void start(uint32_t, const std::vector<ThreadInputData>&, const std::vector<std::atomic<bool>>&, const std::vector<OutputData>&, const OutputData&, double);
+	void stop();
+};
+
+#endif /* CHECKPOINT_H */
@@ -1,5 +1,7 @@
 #include "Chessboard.h"
 
+#include <string.h>
+
 /**
   * @brief  Default constructor
   */
@@ -11,8 +13,11 @@ Chessboard::Chessboard() : Chessboard(0, 0) { }
   * @param  n height
   */
 Chessboard::Chessboard(uint8_t m, uint8_t n) 
-: width(m), height(n), totalWidth(m + 2 * BORDER_OFFSET), totalHeight(n + 2 * BORDER_OFFSET), matrix(totalWidth * totalHeight, 0b11111111), length(0) {
+: width(m), height(n), totalWidth(m + 2 * BORDER_OFFSET), totalHeight(n + 2 * BORDER_OFFSET), matrix(nullptr), moveTable(MoveTable::forWidth(totalWidth)), length(0) {
+  selectStorage();
+  memset(this->matrix, 0b11111111, this->totalWidth * this->totalHeight);
   setBorder();
+  setupMoves();
 }
 
 /**
@@ -20,6 +25,57 @@ Chessboard::Chessboard(uint8_t m, uint8_t n)
   */
 Chessboard::~Chessboard() { }
 
+/**
+  * @brief  Copy constructor. Boards that fit into the inline cells are copied without an allocation.
+  * @param  other The chessboard to copy
+  */
+Chessboard::Chessboard(const Chessboard& other)
+: width(other.width), height(other.height), totalWidth(other.totalWidth), totalHeight(other.totalHeight), matrix(nullptr),
+  moveTable(other.moveTable), root(other.root), rootIndex(other.rootIndex), length(other.length) {
+  selectStorage();
+  memcpy(this->matrix, other.matrix, CHESSBOARD_PLANES * this->totalWidth * this->totalHeight);
+}
+
+/**
+  * @brief  Copy assignment. Boards that fit into the inline cells are copied without an allocation.
+  * @param  other The chessboard to copy
+  * @retval This chessboard
+  */
+Chessboard& Chessboard::operator=(const Chessboard& other) {
+  if(this != &other) {
+    this->width = other.width;
+    this->height = other.height;
+    this->totalWidth = other.totalWidth;
+    this->totalHeight = other.totalHeight;
+    this->moveTable = other.moveTable;
+    this->root = other.root;
+    this->rootIndex = other.rootIndex;
+    this->length = other.length;
+    selectStorage();
+    memcpy(this->matrix, other.matrix, CHESSBOARD_PLANES * this->totalWidth * this->totalHeight);
+  }
+  return *this;
+}
+
+/**
+  * @brief  Selects the storage of the fields: the inline cells, or the overflow vector if the board is too large for them.
+  *         The reserved moves and the crossings follow the moves of the fields in the same storage, so a copy is one memcpy.
+  * @param  None
+  * @retval None
+  */
+void Chessboard::selectStorage() {
+  uint32_t fields = this->totalWidth * this->totalHeight;
+  if(fields <= CHESSBOARD_INLINE_FIELDS) {
+    this->overflow.clear();
+    this->matrix = this->cells;
+  }else{
+    this->overflow.resize(CHESSBOARD_PLANES * fields);
+    this->matrix = this->overflow.data();
+  }
+  this->reserved = this->matrix + fields;
+  this->crossings = this->matrix + 2 * fields;
+}
+
 /**
   * @brief  Sets all fields with their moves as empty and sets the border to 0b11111111
   * @param  None
@@ -33,6 +89,73 @@ void Chessboard::setBorder() {
   }
 }
 
+/**
+  * @brief  Calculates the reserved moves and the crossings of all fields of the board from scratch.
+  *         Afterwards they are updated with every change of a field, see changeField().
+  * @param  None
+  * @retval None
+  */
+void Chessboard::setupMoves() {
+  uint32_t fields = this->totalWidth * this->totalHeight;
+  memset(this->reserved, 0, (CHESSBOARD_PLANES - 1) * fields);
+  for(int y = 0; y < this->height; y++){
+    for(int x = 0; x < this->width; x++){
+      uint16_t index = (y + BORDER_OFFSET) * this->totalWidth + x + BORDER_OFFSET;
+      for(uint8_t i = 0; i < MOVE_COUNT; i++){
+        uint16_t target = index + this->moveTable->moveOffset[i];
+        if(this->matrix[target] != 0b00000000 && (target != this->rootIndex || this->matrix[target] == 0b11111111)) { this->reserved[index] |= 1 << i; }
+      }
+      if(this->matrix[index] != 0b00000000 && this->matrix[index] != 0b11111111) { countCrossings(index, this->matrix[index], 1); }
+    }
+  }
+}
+
+/**
+  * @brief  Changes the moves of a field and updates the blocked moves of the fields around it. Only the fields that reach
+  *         the field with a move and the fields whose moves cross one of the changed edges are touched.
+  *         Blocked fields (0b11111111) reserve their field but have no edges.
+  * @param  index The field index
+  * @param  moves The new moves of the field
+  * @retval None
+  */
+void Chessboard::changeField(uint16_t index, uint8_t moves) {
+  uint8_t previous = this->matrix[index];
+  this->matrix[index] = moves;
+  const MoveTable* table = this->moveTable;
+
+  //The moves to the root stay open, so the path can be closed
+  if((moves != 0b00000000) != (previous != 0b00000000) && index != this->rootIndex) {
+    for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+      uint16_t source = index - table->moveOffset[i];
+      this->reserved[source] = moves != 0b00000000 ? (this->reserved[source] | (1 << i)) : (this->reserved[source] & ~(1 << i));
+    }
+  }
+
+  uint8_t edges = moves != 0b11111111 ? moves : 0b00000000;
+  uint8_t previousEdges = previous != 0b11111111 ? previous : 0b00000000;
+  countCrossings(index, edges & ~previousEdges, 1);
+  countCrossings(index, previousEdges & ~edges, -1);
+}
+
+/**
+  * @brief  Adds or removes edges of a field in the crossings of the moves they cross (see figure 5). A move is crossed
+  *         as long as at least one edge crosses it. An edge is stored on both of its fields, each side counts its own
+  *         crossings, so the counts only hold together with the moves of the fields.
+  * @param  index The field index
+  * @param  edges The edges of the field that are added or removed
+  * @param  delta 1 for added edges, -1 for removed edges
+  * @retval None
+  */
+void Chessboard::countCrossings(uint16_t index, uint8_t edges, int8_t delta) {
+  for(; edges != 0; edges &= edges - 1) {
+    uint8_t b = __builtin_ctz(edges);
+    for(uint8_t j = 0; j < CROSSING_COUNT; j++) {
+      uint16_t source = index + this->moveTable->crossingOffset[b][j];
+      this->crossings[source * MOVE_COUNT + MoveTable::crossingMove[b][j]] += delta;
+    }
+  }
+}
+
 /**
   * @brief  Returns value of area on chessboard
   * @param  m x-position of chessboard
@@ -55,8 +178,7 @@ std::pair<uint8_t, uint8_t> Chessboard::getRoot() const{
   * @see    getLength()
   */
 void Chessboard::setField(uint8_t moves, std::pair<uint8_t, uint8_t> field) {
-  this->matrix[field.second * this->totalWidth + field.first] = moves;
-  this->length++;
+  this->setField(moves, toIndex(field));
 }
 
 /**
@@ -67,11 +189,23 @@ void Chessboard::setField(uint8_t moves, std::pair<uint8_t, uint8_t> field) {
   * @see    setField()
   */
 void Chessboard::updateField(uint8_t moves, std::pair<uint8_t, uint8_t> field){
-  this->matrix[field.second * this->totalWidth + field.first] = moves;
+  this->updateField(moves, toIndex(field));
+}
+
+/**
+  * @brief  Reverts a previous setField() call. Clears the moves of the field and decreases the path length by one.
+  *         Used by the in-place backtracking to restore the board when returning from a node.
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    setField()
+  */
+void Chessboard::unsetField(std::pair<uint8_t, uint8_t> field){
+  this->unsetField(toIndex(field));
 }
 
 /**
   * @brief  Sets a field as root. Increases the path length of the path by one.
+  *         The moves to the root aren't reserved, see getOpenMoves(). The root needs to be a free field.
   * @param  moves The moves to set
   * @param  _root The coordinates of the root
   * @retval None
@@ -80,6 +214,7 @@ void Chessboard::updateField(uint8_t moves, std::pair<uint8_t, uint8_t> field){
   */
 void Chessboard::setRoot(uint8_t moves, std::pair<uint8_t, uint8_t> _root){
   this->root = _root;
+  this->rootIndex = toIndex(_root);
   this->setField(moves, _root);
 }
 
@@ -119,6 +254,15 @@ uint16_t Chessboard::getTotalHeight() const {
   return this->totalHeight;
 }
 
+/**
+  * @brief  Returns the move table of the chessboard with the flat index offsets for its width.
+  * @param  None
+  * @retval The move table
+  */
+const MoveTable* Chessboard::getMoveTable() const {
+  return this->moveTable;
+}
+
 /**
   * @brief  Returns the current paths length.
   * @param  None
@@ -150,32 +294,13 @@ void Chessboard::debug() const {
 
 /**
   * @brief  Returns the target of a move from the knight. Does not alter the chessboard.
-  * @param  node    Node to be moved
   * @param  source  The current field of the knight
-  * @param  move    The move of the knight in the bit format
+  * @param  move    The move of the knight in the bit format (exactly one bit set)
   * @retval The target node position
   */
 std::pair<uint8_t, uint8_t> Chessboard::doMove(std::pair<uint8_t, uint8_t> source, uint8_t move) const{
-    switch(move) {
-        case 0b00000001:
-            return std::make_pair(source.first+1, source.second+2);
-        case 0b00000010:
-            return std::make_pair(source.first+2, source.second+1);
-        case 0b00000100:
-            return std::make_pair(source.first+2, source.second-1);
-        case 0b00001000:
-            return std::make_pair(source.first+1, source.second-2);
-        case 0b00010000:
-            return std::make_pair(source.first-1, source.second-2);
-        case 0b00100000:
-            return std::make_pair(source.first-2, source.second-1); 
-        case 0b01000000:
-            return std::make_pair(source.first-2, source.second+1); 
-        case 0b10000000:
-            return std::make_pair(source.first-1, source.second+2);
-        default: 
-            return std::make_pair(source.first, source.first);
-    }
+  uint8_t i = MoveTable::index(move);
+  return std::make_pair(source.first + MoveTable::moveDx[i], source.second + MoveTable::moveDy[i]);
 }
 
 /**
@@ -228,95 +353,198 @@ bool Chessboard::isCandidateConnected( uint8_t x, uint8_t y, uint8_t moves) {
 }
 
 /**
-  * @brief  Checks if the edge to the node crosses another edge. Iterates over all cases (see figure 5).
+  * @brief  Checks if the edge to the node crosses another edge.
   * @param  source  The position of the node to check
-  * @param  moves   The edges to check a possible crossing with
+  * @param  moves   The edge to check a possible crossing with (exactly one bit set)
   * @retval true:   The move crosses an existing connection
   *         false:  The move doesn't cross an existing connection
+  * @see    isConnectionCrossesEdge(uint16_t, uint8_t)
   */
 bool Chessboard::isConnectionCrossesEdge(std::pair<uint8_t, uint8_t> source, uint8_t moves) {
-  switch(moves) {
-      case 0b00000001:
-        // blue case, (x+1,y+1), 11100000
-        return isCandidateConnected(source.first+1, source.second+1, 0b11100000) ||
-        // orange case, (x,y+1), 00001110
-        isCandidateConnected(source.first, source.second+1, 0b00001110) ||
-        // purple case, (x,y+2), 00001100
-        isCandidateConnected(source.first, source.second+2, 0b00001100) ||
-        // green case, (x+1,y), 01000000
-        isCandidateConnected(source.first+1, source.second, 0b01000000);
-
-      case 0b00000010:
-        // orange case, (x+1,y+1), 00011100
-        return isCandidateConnected(source.first+1, source.second+1, 0b00011100) ||
-        // blue case, (x+1,y), 11000001
-        isCandidateConnected(source.first+1, source.second, 0b11000001) ||
-        // purple case, (x+2,y), 11000000
-        isCandidateConnected(source.first+2, source.second, 0b11000000) ||
-        // green case, (x,y+1), 00001000
-        isCandidateConnected(source.first, source.second+1, 0b00001000);
-
-      case 0b00000100:
-        // blue case, (x+1,y-1), 10000011
-        return isCandidateConnected(source.first+1, source.second-1, 0b10000011) ||
-        // orange case, (x+1,y), 00111000
-        isCandidateConnected(source.first+1, source.second, 0b00111000) ||
-        // purple case, (x+2,y), 00110000
-        isCandidateConnected(source.first+2, source.second, 0b00110000) ||
-        // green case, (x,y-1), 00000001
-        isCandidateConnected(source.first, source.second-1, 0b00000001);
-
-      case 0b00001000:
-        // orange case, (x+1,y-1), 01110000
-        return isCandidateConnected(source.first+1, source.second-1, 0b01110000) ||
-        // blue case, (x,y-1), 00000111
-        isCandidateConnected(source.first, source.second-1, 0b00000111) ||
-        // purple case, (x,y-2), 00000011
-        isCandidateConnected(source.first, source.second-2, 0b00000011) ||
-        // green case, (x+1,y), 00100000
-        isCandidateConnected(source.first+1, source.second, 0b00100000);
-
-      case 0b00010000:
-        // blue case, (x-1,y-1), 00001110
-        return isCandidateConnected(source.first-1, source.second-1, 0b00001110) ||
-        // orange case, (x,y-1), 11100000
-        isCandidateConnected(source.first, source.second-1, 0b11100000) ||
-        // purple case, (x,y-2), 11000000
-        isCandidateConnected(source.first, source.second-2, 0b11000000) ||
-        // green case, (x-1,y), 00000100
-        isCandidateConnected(source.first-1, source.second, 0b00000100);
-
-      case 0b00100000:
-        // orange case, (x-1,y-1), 11000001
-        return isCandidateConnected(source.first-1, source.second-1, 0b11000001) ||
-        // blue case, (x-1,y), 00011100
-        isCandidateConnected(source.first-1, source.second, 0b00011100) ||
-        // purple case, (x-2,y), 00001100
-        isCandidateConnected(source.first-2, source.second, 0b00001100) ||
-        // green case, (x,y-1), 10000000
-        isCandidateConnected(source.first, source.second-1, 0b10000000);
-
-      case 0b01000000:
-        // blue case, (x-1,y+1), 00111000
-        return isCandidateConnected(source.first-1, source.second, 0b10000011) ||
-        // orange case, (x-1,y), 10000011
-        isCandidateConnected(source.first-1, source.second+1, 0b00111000) ||
-        // purple case, (x-2,y), 00000011
-        isCandidateConnected(source.first-2, source.second, 0b00000011) ||
-        // green case, (x,y+1), 00010000
-        isCandidateConnected(source.first, source.second+1, 0b00010000);
-
-      case 0b10000000:
-        // orange case, (x-1,y+1), 00000111
-        return isCandidateConnected(source.first-1, source.second+1, 0b00000111) ||
-        // blue case, (x,y+1), 01110000
-        isCandidateConnected(source.first, source.second+1, 0b01110000) ||
-        // purple case, (x,y+2), 00110000
-        isCandidateConnected(source.first, source.second+2, 0b00110000) ||
-        // green case, (x-1,y), 00000010
-        isCandidateConnected(source.first-1, source.second, 0b00000010);
-
-      default:
-        return true;
+  return isConnectionCrossesEdge(toIndex(source), moves);
+}
+
+/**
+  * @brief  Converts a position to its flat field index.
+  * @param  field The position of the field (including the border offset)
+  * @retval The field index
+  */
+uint16_t Chessboard::toIndex(std::pair<uint8_t, uint8_t> field) const {
+  return field.second * this->totalWidth + field.first;
+}
+
+/**
+  * @brief  Converts a flat field index back to its position, e.g. for exporting or debugging.
+  * @param  index The field index
+  * @retval The position of the field (including the border offset)
+  */
+std::pair<uint8_t, uint8_t> Chessboard::toField(uint16_t index) const {
+  return std::make_pair(index % this->totalWidth, index / this->totalWidth);
+}
+
+/**
+  * @brief  Returns the field index of the root.
+  * @param  None
+  * @retval The field index of the root
+  */
+uint16_t Chessboard::getRootIndex() const {
+  return this->rootIndex;
+}
+
+/**
+  * @brief  Returns the moves of a field.
+  * @param  index The field index
+  * @retval Moves in given field
+  */
+uint8_t Chessboard::at(uint16_t index) const {
+  return this->matrix[index];
+}
+
+/**
+  * @brief  Sets the moves to a field. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  index The field index
+  * @retval None
+  */
+void Chessboard::setField(uint8_t moves, uint16_t index) {
+  this->changeField(index, moves);
+  this->length++;
+}
+
+/**
+  * @brief  Updates the moves of a field. This doesn't alter the path length.
+  * @param  moves The moves to set
+  * @param  index The field index
+  * @retval None
+  */
+void Chessboard::updateField(uint8_t moves, uint16_t index) {
+  this->changeField(index, moves);
+}
+
+/**
+  * @brief  Reverts a previous setField() call. Clears the moves of the field and decreases the path length by one.
+  * @param  index The field index
+  * @retval None
+  */
+void Chessboard::unsetField(uint16_t index) {
+  this->changeField(index, 0b00000000);
+  this->length--;
+}
+
+/**
+  * @brief  Blocks all free fields with a smaller field index than the given one. Blocked fields are treated like
+  *         border fields, so they are neither free nor a connection. This doesn't alter the path length.
+  * @param  index The field index of the first field that stays free
+  * @retval None
+  */
+void Chessboard::blockFieldsBefore(uint16_t index) {
+  for(uint16_t i = 0; i < index; i++) {
+    if(this->matrix[i] == 0b00000000) { this->matrix[i] = 0b11111111; }
+  }
+  setupMoves();
+}
+
+/**
+  * @brief  Returns the target of a move from the knight. The move is a constant index delta from the move table.
+  *         Moves over the edge of the board end in a border field.
+  * @param  source  The field index of the knight
+  * @param  move    The move of the knight in the bit format (exactly one bit set)
+  * @retval The field index of the target
+  */
+uint16_t Chessboard::doMove(uint16_t source, uint8_t move) const {
+  return source + this->moveTable->moveOffset[MoveTable::index(move)];
+}
+
+/**
+  * @brief  Checks if the given move finishes the path. Checks that the move isn't backwards.
+  * @param  source        The field index of the start of the move
+  * @param  target        The field index of the target of the move
+  * @param  outgoing_move The move represented in the bit format
+  * @retval true:   The move closes the path
+  *         false:  The move doesn't close the path
+  */
+bool Chessboard::isFinishable(uint16_t source, uint16_t target, uint8_t outgoing_move) const {
+  return target == this->rootIndex && source != this->rootIndex && !isConnectionCrossesEdge(source, outgoing_move);
+}
+
+/**
+  * @brief  Checks whether a field is already a part of the path. Border fields are always reserved.
+  * @param  index   The field index
+  * @retval true:   Node is already a part of the path or a border field
+  *         false:  Node is currently not a part of the path
+  */
+bool Chessboard::isFieldReserved(uint16_t index) const {
+  return this->matrix[index] != 0b00000000;
+}
+
+/**
+  * @brief  Checks if the edge to the node crosses another edge. The crossings of each move are kept up to date
+  *         by changeField(), so this is a single lookup.
+  * @param  source  The field index of the node to check
+  * @param  moves   The edge to check a possible crossing with (exactly one bit set)
+  * @retval true:   The move crosses an existing connection
+  *         false:  The move doesn't cross an existing connection
+  */
+bool Chessboard::isConnectionCrossesEdge(uint16_t source, uint8_t moves) const {
+  return this->crossings[source * MOVE_COUNT + MoveTable::index(moves)] != 0;
+}
+
+/**
+  * @brief  Returns the moves of a field that are neither crossed nor lead to a reserved field. The move to the root
+  *         is open if it isn't crossed, it closes the path. A free field with less than two open moves is a dead end.
+  * @param  source  The field index
+  * @retval The open moves in the bit format
+  */
+uint8_t Chessboard::getOpenMoves(uint16_t source) const {
+  return ~(MoveTable::crossedMoves(&this->crossings[source * MOVE_COUNT]) | this->reserved[source]);
+}
+
+/**
+  * @brief  Counts the free fields that the path can still visit: the fields that the knight can reach from a field over
+  *         open moves, the field itself included. Moves that cross the path aren't open, so the path walls off parts of the board.
+  *         The new moves can't cross each other either, which is ignored, so the path can't visit more fields from here.
+  *         The path also needs to return to the root, if none of the fields has an open move to the root, 0 is returned.
+  *         This is used as upper bound for pruning. The search stops as soon as limit fields and the root are found.
+  *         The buffers are kept per thread, so there is no allocation per call.
+  * @param  source  The field index to start from
+  * @param  limit   The number of fields after which the counting stops
+  * @retval The number of reachable free fields, at most limit. 0 if the root can't be reached.
+  */
+uint16_t Chessboard::countReachable(uint16_t source, uint16_t limit) const {
+  static thread_local std::vector<uint16_t> queue;
+  static thread_local std::vector<uint8_t> visited;
+  size_t fields = this->totalWidth * this->totalHeight;
+  if(visited.size() < fields) { visited.resize(fields, 0); }
+
+  bool closable = false;
+  queue.clear();
+  queue.push_back(source);
+  visited[source] = 1;
+  for(size_t q = 0; q < queue.size() && (queue.size() < limit || !closable); q++) {
+    for(uint8_t open = getOpenMoves(queue[q]); open != 0; open &= open - 1) {
+      uint16_t target = queue[q] + this->moveTable->moveOffset[MoveTable::index(open)];
+      if(target == this->rootIndex) {
+        closable = true;
+      }else if(!visited[target]) {
+        visited[target] = 1;
+        queue.push_back(target);
+      }
     }
+  }
+
+  for(uint16_t index : queue) { visited[index] = 0; }
+  if(!closable) { return 0; }
+  return queue.size() < limit ? queue.size() : limit;
+}
+
+/**
+  * @brief  Checks whether the path can still be closed: the root needs to be reachable from source over open moves,
+  *         so the moves that cross the path wall off parts of the board. It shares the search of countReachable(),
+  *         which stops as soon as the root is found.
+  * @param  source  The field index to start from
+  * @retval true:   The root can be reached
+  *         false:  The root can't be reached anymore
+  */
+bool Chessboard::isRootReachable(uint16_t source) const {
+  return countReachable(source, 1) != 0;
 }
@@ -39,30 +39,59 @@ uint8_t FileExporter::getNextMove(Chessboard& cboard, uint8_t moves, uint8_t pre
   */
 void FileExporter::exportPath(Chessboard &cboard, uint16_t number = 1)
 {
-    std::pair<uint8_t, uint8_t> root = cboard.getRoot();
     //Create and open the file
     char filename[30];
     sprintf(filename, "./paths/%ix%i_%i.path", cboard.getWidth(), cboard.getHeight(), number);
     std::ofstream file(filename);
+    writePath(cboard, file);
+    file.close();
+}
+
+/**
+  * @brief  This function stores the longest path so far of a search in ./paths/MxN_best.path. The file is written to a
+  *         temporary file first and renamed, so a search that is killed while writing keeps the previous path.
+  * @param  cboard  The chessboard of the path to store
+  */
+void FileExporter::exportBestPath(Chessboard &cboard)
+{
+    char filename[30];
+    sprintf(filename, "./paths/%ix%i_best.path", cboard.getWidth(), cboard.getHeight());
+    std::string temporary = std::string(filename) + ".tmp";
+    std::ofstream file(temporary);
+    writePath(cboard, file);
+    file.close();
+
+    std::rename(temporary.c_str(), filename);
+}
+
+/**
+  * @brief  This function writes the board information and the fields of the path of a chessboard.
+  * @param  cboard  The chessboard of the path to write
+  * @param  file    The file to write to
+  */
+void FileExporter::writePath(Chessboard &cboard, std::ofstream &file)
+{
+    uint16_t root = cboard.getRootIndex();
 
     //Write board information
     file << "m=" << (int) cboard.getWidth() << std::endl;
     file << "n=" << (int) cboard.getHeight() << std::endl;
 
     //Getting the first root move
-    uint8_t movingMove = getRootMove(cboard.at(root.first, root.second));
+    uint8_t movingMove = getRootMove(cboard.at(root));
 
     //Iterate over all moves
-    std::pair<uint8_t, uint8_t> currentField = root;
+    uint16_t currentField = root;
     uint16_t move = 0;
-    while (!(currentField.first == root.first && currentField.second == root.second) || move == 0)
+    while (currentField != root || move == 0)
     {
         //Write the field coordinates to the file
-        file << "(" << (int) currentField.first-2 << "," << (int) currentField.second-2 << ")" << std::endl;
+        std::pair<uint8_t, uint8_t> position = cboard.toField(currentField);
+        file << "(" << (int) position.first-2 << "," << (int) position.second-2 << ")" << std::endl;
 
         //Get next field and the correct next move, that is not the backwards path
         currentField = cboard.doMove(currentField, movingMove);
-        movingMove = getNextMove(cboard, cboard.at(currentField.first, currentField.second), movingMove);
+        movingMove = getNextMove(cboard, cboard.at(currentField), movingMove);
     
         //Break if there was an error with the path, to prevent an infinity loop and file wirting
         move++;
@@ -74,6 +103,92 @@ void FileExporter::exportPath(Chessboard &cboard, uint16_t number = 1)
             file << "Path was not completed. Aborting!" << std::endl;
         }
     }
-    
+}
+
+/**
+  * @brief  This function stores the estimated size and the measured time of each start configuration in a csv file,
+  *         so the estimation can be compared with the actual time of the subtrees.
+  * @param  cboard  The chessboard of the run, used for the file name
+  * @param  input   The start configurations with their estimate
+  * @param  output  The outputs of the start configurations with their time
+  */
+void FileExporter::exportEstimates(Chessboard &cboard, std::vector<ThreadInputData>& input, std::vector<OutputData>& output)
+{
+    char filename[40];
+    sprintf(filename, "./paths/%ix%i_estimates.csv", cboard.getWidth(), cboard.getHeight());
+    std::ofstream file(filename);
+
+    file << "root,source,length,estimate,seconds" << std::endl;
+    for(size_t i = 0; i < input.size(); i++){
+        std::pair<uint8_t, uint8_t> root = input[i].cboard.getRoot();
+        std::pair<uint8_t, uint8_t> source = input[i].cboard.toField(input[i].source);
+        file << "(" << (int) root.first-2 << "," << (int) root.second-2 << "),";
+        file << "(" << (int) source.first-2 << "," << (int) source.second-2 << "),";
+        file << input[i].cboard.getLength() << "," << input[i].estimate << "," << output[i].seconds << std::endl;
+    }
+
+    file.close();
+}
+
+/**
+  * @brief  This function stores the result of a shard in a file, so the results of all shards can be merged afterwards.
+  * @param  cboard  The chessboard of the run, used for the file name
+  * @param  index   The index of the shard
+  * @param  count   The number of shards
+  * @param  result  The merged result of the start configurations of the shard
+  */
+void FileExporter::exportShardResult(Chessboard &cboard, uint16_t index, uint16_t count, const OutputData& result)
+{
+    char filename[50];
+    sprintf(filename, "./paths/%ix%i_shard_%i_of_%i.result", cboard.getWidth(), cboard.getHeight(), index, count);
+    std::ofstream file(filename);
+
+    file << "shard " << index << " " << count << std::endl;
+    LUKPSerializer::writeOutput(file, result);
+    file << std::endl;
+
+    file.close();
+}
+
+/**
+  * @brief  This function reads the result of a shard that was stored by exportShardResult().
+  * @param  cboard  The chessboard of the run, used for the file name
+  * @param  index   The index of the shard
+  * @param  count   The number of shards
+  * @param  result  The result of the shard
+  * @retval true:   The result was read
+  *         false:  The file is missing or incomplete
+  */
+bool FileExporter::importShardResult(Chessboard &cboard, uint16_t index, uint16_t count, OutputData& result)
+{
+    char filename[50];
+    sprintf(filename, "./paths/%ix%i_shard_%i_of_%i.result", cboard.getWidth(), cboard.getHeight(), index, count);
+    std::ifstream file(filename);
+    if(!file.is_open()){
+        return false;
+    }
+
+    std::string key;
+    uint16_t fileIndex = 0, fileCount = 0;
+    file >> key >> fileIndex >> fileCount;
+    result = LUKPSerializer::readOutput(file);
+    return !file.fail() && fileIndex == index && fileCount == count;
+}
+
+/**
+  * @brief  This function stores the results of all board sizes of a batch in a csv file.
+  *         The number of paths is empty if they weren't counted.
+  * @param  rows  The results of the board sizes
+  */
+void FileExporter::exportBatchResults(const std::vector<BatchResult>& rows)
+{
+    std::ofstream file("./paths/batch.csv");
+
+    file << "width,height,length,count,seconds,thread_seconds,nodes" << std::endl;
+    for(const BatchResult& row : rows){
+        file << (int) row.width << "," << (int) row.height << "," << row.result.longestPathLength << "," << row.result.longestPathCount << ",";
+        file << row.seconds << "," << row.threadSeconds << "," << row.result.nodes << std::endl;
+    }
+
     file.close();
 }
@@ -3,17 +3,29 @@
 
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <cstdio>
+
+#include <vector>
 
 #include "Chessboard.h"
+#include "LUKPData.h"
+#include "LUKPSerializer.h"
 
 class FileExporter
 {
 private:
     uint8_t getRootMove(uint8_t);
     uint8_t getNextMove(Chessboard&, uint8_t, uint8_t);
+    void writePath(Chessboard &, std::ofstream &);
 
 public:
     void exportPath(Chessboard &, uint16_t);
+    void exportBestPath(Chessboard &);
+    void exportEstimates(Chessboard &, std::vector<ThreadInputData>&, std::vector<OutputData>&);
+    void exportShardResult(Chessboard &, uint16_t, uint16_t, const OutputData&);
+    bool importShardResult(Chessboard &, uint16_t, uint16_t, OutputData&);
+    void exportBatchResults(const std::vector<BatchResult>&);
 };
 
 #endif /* FILEEXPORTER_H */
\ No newline at end of file
@@ -0,0 +1,300 @@
+#ifndef FIXEDCHESSBOARD_H
+#define FIXEDCHESSBOARD_H
+
+#include <stdint.h>
+#include <string.h>
+#include <iostream>
+
+#include "Chessboard.h"
+#include "MoveTable.h"
+
+//The board sizes that get a specialised kernel. Each size is expanded with X(width, height).
+#define FIXED_CHESSBOARD_SIZES(X) \
+    X(5, 5)  X(6, 6)  X(7, 7)  X(8, 8)  X(9, 9)  X(10, 10) \
+    X(5, 6)  X(6, 5)  X(6, 7)  X(7, 6)  X(7, 8)  X(8, 7) \
+    X(8, 9)  X(9, 8)  X(9, 10) X(10, 9)
+
+//Combines width and height to one value, so the dispatch can switch over the board sizes
+#define FIXED_CHESSBOARD_KEY(m, n) (((m) << 8) | (n))
+
+/**
+ * Chessboard with the width and height known at compile time. It stores the same padded byte matrix as the Chessboard,
+ * but inline, and provides the field index interface of the backtracking. Since the row length is a constant,
+ * all move and crossing offsets are constants as well. The compiler can fold them into the kernel and unroll the move loop.
+ * Like the Chessboard it keeps the reserved moves and the crossings of each field up to date, see Chessboard::changeField().
+ * Only the sizes in FIXED_CHESSBOARD_SIZES get a specialised kernel, all other sizes use the Chessboard or the Bitboard.
+ */
+template<uint8_t W, uint8_t H>
+class FixedChessboard {
+    public:
+        static constexpr uint16_t TOTAL_WIDTH = W + 2*BORDER_OFFSET;
+        static constexpr uint16_t TOTAL_HEIGHT = H + 2*BORDER_OFFSET;
+
+    private:
+        uint8_t matrix[TOTAL_WIDTH * TOTAL_HEIGHT];
+        uint8_t reserved[TOTAL_WIDTH * TOTAL_HEIGHT];
+        uint8_t crossings[TOTAL_WIDTH * TOTAL_HEIGHT][MOVE_COUNT];
+        std::pair<uint8_t, uint8_t> root;
+        uint16_t rootIndex = 0;
+        uint16_t length = 0;
+
+        static constexpr int16_t moveOffset(uint8_t i) {
+            return MoveTable::moveDx[i] + MoveTable::moveDy[i] * TOTAL_WIDTH;
+        }
+        static constexpr int16_t crossingOffset(uint8_t b, uint8_t j) {
+            return MoveTable::crossingDx[b][j] + MoveTable::crossingDy[b][j] * TOTAL_WIDTH;
+        }
+
+        void setupMoves();
+        void changeField(uint16_t, uint8_t);
+        template<int8_t DELTA> void countCrossings(uint16_t, uint8_t);
+        template<uint8_t B, int8_t DELTA> void countCrossingsOf(uint16_t);
+
+    public:
+        FixedChessboard();
+        explicit FixedChessboard(const Chessboard&);
+        explicit operator Chessboard() const;
+
+        void setRoot(uint8_t, std::pair<uint8_t, uint8_t>);
+
+        uint8_t getWidth() const { return W; }
+        uint8_t getHeight() const { return H; }
+        uint16_t getLength() const { return this->length; }
+
+        void debug() const;
+
+        //Flat field index (y * TOTAL_WIDTH + x), the same numbering as the Chessboard
+        uint16_t toIndex(std::pair<uint8_t, uint8_t> field) const { return field.second * TOTAL_WIDTH + field.first; }
+        std::pair<uint8_t, uint8_t> toField(uint16_t index) const { return std::make_pair(index % TOTAL_WIDTH, index / TOTAL_WIDTH); }
+        uint16_t getRootIndex() const { return this->rootIndex; }
+
+        uint8_t at(uint16_t index) const { return this->matrix[index]; }
+        void setField(uint8_t moves, uint16_t index) { this->changeField(index, moves); this->length++; }
+        void updateField(uint8_t moves, uint16_t index) { this->changeField(index, moves); }
+        void unsetField(uint16_t index) { this->changeField(index, 0b00000000); this->length--; }
+
+        //Moves
+        uint16_t doMove(uint16_t source, uint8_t move) const { return source + moveOffset(MoveTable::index(move)); }
+        uint8_t rotate180(uint8_t move) const { return (move << 4) | (move >> 4); }
+
+        //Field checking
+        bool isFinishable(uint16_t, uint16_t, uint8_t) const;
+        bool isFieldReserved(uint16_t index) const { return this->matrix[index] != 0b00000000; }
+        bool isConnectionCrossesEdge(uint16_t source, uint8_t moves) const { return this->crossings[source][MoveTable::index(moves)] != 0; }
+        uint8_t getOpenMoves(uint16_t source) const { return ~(MoveTable::crossedMoves(this->crossings[source]) | this->reserved[source]); }
+        uint16_t countReachable(uint16_t, uint16_t) const;
+        bool isRootReachable(uint16_t) const;
+};
+
+/**
+  * @brief  Constructor of an empty board. The border is set to 0b11111111.
+  *         Boards are default constructed often, e.g. for the results of the tasks, so the empty board with its
+  *         blocked moves is only calculated once and then copied.
+  */
+template<uint8_t W, uint8_t H>
+FixedChessboard<W, H>::FixedChessboard() : root(0, 0) {
+    static const FixedChessboard<W, H> empty(Chessboard(W, H));
+    *this = empty;
+}
+
+/**
+  * @brief  Creates the board from a chessboard of the same size, e.g. from a start configuration.
+  * @param  cboard The chessboard to copy
+  */
+template<uint8_t W, uint8_t H>
+FixedChessboard<W, H>::FixedChessboard(const Chessboard& cboard) : root(cboard.getRoot()), rootIndex(cboard.getRootIndex()), length(cboard.getLength()) {
+    for(uint16_t i = 0; i < TOTAL_WIDTH * TOTAL_HEIGHT; i++) {
+        this->matrix[i] = cboard.at(i);
+    }
+    this->setupMoves();
+}
+
+/**
+  * @brief  Converts the board back to a chessboard, e.g. to store or export a path or to split off a subtree.
+  *         Blocked fields stay blocked, e.g. the fields before the root with canonical roots.
+  * @retval The chessboard with the same path
+  */
+template<uint8_t W, uint8_t H>
+FixedChessboard<W, H>::operator Chessboard() const {
+    Chessboard cboard(W, H);
+    for(uint16_t i = 0; i < TOTAL_WIDTH * TOTAL_HEIGHT; i++) {
+        uint8_t moves = this->matrix[i];
+        if(moves == 0b00000000 || cboard.at(i) == 0b11111111) continue;
+
+        if(moves == 0b11111111) {
+            cboard.updateField(moves, i);
+        }else if(i == this->rootIndex) {
+            cboard.setRoot(moves, this->root);
+        }else{
+            cboard.setField(moves, i);
+        }
+    }
+    return cboard;
+}
+
+/**
+  * @brief  Calculates the reserved moves and the crossings of all fields from scratch, like Chessboard::setupMoves().
+  * @retval None
+  */
+template<uint8_t W, uint8_t H>
+void FixedChessboard<W, H>::setupMoves() {
+    memset(this->reserved, 0, sizeof(this->reserved));
+    memset(this->crossings, 0, sizeof(this->crossings));
+    for(uint8_t y = 0; y < H; y++) {
+        for(uint8_t x = 0; x < W; x++) {
+            uint16_t index = (y + BORDER_OFFSET) * TOTAL_WIDTH + x + BORDER_OFFSET;
+            for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+                uint16_t target = index + moveOffset(i);
+                if(this->matrix[target] != 0b00000000 && (target != this->rootIndex || this->matrix[target] == 0b11111111)) { this->reserved[index] |= 1 << i; }
+            }
+            if(this->matrix[index] != 0b00000000 && this->matrix[index] != 0b11111111) { this->countCrossings<1>(index, this->matrix[index]); }
+        }
+    }
+}
+
+/**
+  * @brief  Changes the moves of a field and updates the blocked moves of the fields around it, like Chessboard::changeField().
+  *         With a constant row length all offsets are constants.
+  * @param  index The field index
+  * @param  moves The new moves of the field
+  * @retval None
+  */
+template<uint8_t W, uint8_t H>
+void FixedChessboard<W, H>::changeField(uint16_t index, uint8_t moves) {
+    uint8_t previous = this->matrix[index];
+    this->matrix[index] = moves;
+
+    //The moves to the root stay open, so the path can be closed
+    if((moves != 0b00000000) != (previous != 0b00000000) && index != this->rootIndex) {
+        for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+            uint16_t source = index - moveOffset(i);
+            this->reserved[source] = moves != 0b00000000 ? (this->reserved[source] | (1 << i)) : (this->reserved[source] & ~(1 << i));
+        }
+    }
+
+    uint8_t edges = moves != 0b11111111 ? moves : 0b00000000;
+    uint8_t previousEdges = previous != 0b11111111 ? previous : 0b00000000;
+    this->countCrossings<1>(index, edges & ~previousEdges);
+    this->countCrossings<-1>(index, previousEdges & ~edges);
+}
+
+/**
+  * @brief  Adds or removes edges of a field in the crossings of the moves they cross, like Chessboard::countCrossings().
+  *         Each move is dispatched to its own instance, so its crossing offsets are constants.
+  * @param  index The field index
+  * @param  edges The edges of the field that are added or removed
+  * @retval None
+  */
+template<uint8_t W, uint8_t H>
+template<int8_t DELTA>
+void FixedChessboard<W, H>::countCrossings(uint16_t index, uint8_t edges) {
+    for(; edges != 0; edges &= edges - 1) {
+        switch(__builtin_ctz(edges)) {
+            case 0: this->countCrossingsOf<0, DELTA>(index); break;
+            case 1: this->countCrossingsOf<1, DELTA>(index); break;
+            case 2: this->countCrossingsOf<2, DELTA>(index); break;
+            case 3: this->countCrossingsOf<3, DELTA>(index); break;
+            case 4: this->countCrossingsOf<4, DELTA>(index); break;
+            case 5: this->countCrossingsOf<5, DELTA>(index); break;
+            case 6: this->countCrossingsOf<6, DELTA>(index); break;
+            case 7: this->countCrossingsOf<7, DELTA>(index); break;
+        }
+    }
+}
+
+/**
+  * @brief  Adds or removes the edge B of a field in the crossings of the moves it crosses.
+  * @param  index The field index
+  * @retval None
+  */
+template<uint8_t W, uint8_t H>
+template<uint8_t B, int8_t DELTA>
+void FixedChessboard<W, H>::countCrossingsOf(uint16_t index) {
+    for(uint8_t j = 0; j < CROSSING_COUNT; j++) {
+        uint16_t source = index + crossingOffset(B, j);
+        this->crossings[source][MoveTable::crossingMove[B][j]] += DELTA;
+    }
+}
+
+/**
+  * @brief  Sets a field as root. Increases the path length of the path by one.
+  *         The moves to the root aren't reserved, see Chessboard::getOpenMoves(). The root needs to be a free field.
+  * @param  moves The moves to set
+  * @param  _root The coordinates of the root
+  * @retval None
+  */
+template<uint8_t W, uint8_t H>
+void FixedChessboard<W, H>::setRoot(uint8_t moves, std::pair<uint8_t, uint8_t> _root) {
+    this->root = _root;
+    this->rootIndex = toIndex(_root);
+    this->setField(moves, this->rootIndex);
+}
+
+/**
+  * @brief  Prints the current chessboard to the console.
+  * @param  None
+  * @retval None
+  */
+template<uint8_t W, uint8_t H>
+void FixedChessboard<W, H>::debug() const {
+    static_cast<Chessboard>(*this).debug();
+}
+
+/**
+  * @brief  Checks if the given move finishes the path. Checks that the move isn't backwards.
+  * @param  source        The field index of the start of the move
+  * @param  target        The field index of the target of the move
+  * @param  outgoing_move The move represented in the bit format
+  * @retval true:   The move closes the path
+  *         false:  The move doesn't close the path
+  */
+template<uint8_t W, uint8_t H>
+bool FixedChessboard<W, H>::isFinishable(uint16_t source, uint16_t target, uint8_t outgoing_move) const {
+    return target == this->rootIndex && source != this->rootIndex && !isConnectionCrossesEdge(source, outgoing_move);
+}
+
+/**
+  * @brief  Counts the free fields that the path can still visit over open moves, like Chessboard::countReachable().
+  *         The buffers have a constant size and are kept per thread.
+  * @param  source  The field index to start from
+  * @param  limit   The number of fields after which the counting stops
+  * @retval The number of reachable free fields, at most limit. 0 if the root can't be reached.
+  */
+template<uint8_t W, uint8_t H>
+uint16_t FixedChessboard<W, H>::countReachable(uint16_t source, uint16_t limit) const {
+    static thread_local uint16_t queue[W * H];
+    static thread_local bool visited[TOTAL_WIDTH * TOTAL_HEIGHT];
+
+    bool closable = false;
+    uint16_t count = 0;
+    queue[count++] = source;
+    visited[source] = true;
+    for(uint16_t q = 0; q < count && (count < limit || !closable); q++) {
+        for(uint8_t open = this->getOpenMoves(queue[q]); open != 0; open &= open - 1) {
+            uint16_t target = queue[q] + moveOffset(MoveTable::index(open));
+            if(target == this->rootIndex) {
+                closable = true;
+            }else if(!visited[target]) {
+                visited[target] = true;
+                queue[count++] = target;
+            }
+        }
+    }
+
+    for(uint16_t q = 0; q < count; q++) { visited[queue[q]] = false; }
+    if(!closable) { return 0; }
+    return count < limit ? count : limit;
+}
+
+/**
+  * @brief  Checks whether the path can still be closed, like Chessboard::isRootReachable().
+  * @param  source  The field index to start from
+  * @retval true:   The root can be reached
+  *         false:  The root can't be reached anymore
+  */
+template<uint8_t W, uint8_t H>
+bool FixedChessboard<W, H>::isRootReachable(uint16_t source) const {
+    return countReachable(source, 1) != 0;
+}
+
+#endif /* FIXEDCHESSBOARD_H */
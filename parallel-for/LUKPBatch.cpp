@@ -0,0 +1,207 @@
+#include "LUKPBatch.h"
+
+/**
+  * @brief  Constructor of a batch.
+  * @param  _options The search options, they are used for all board sizes
+  * @param  _threads The number of threads, 0 for all
+  */
+LUKPBatch::LUKPBatch(const SearchOptions& _options, uint16_t _threads) : options(_options), threads(_threads) { }
+
+/**
+  * @brief  Parses the board sizes of a batch. The sizes are separated by commas, each is a single size (5x6)
+  *         or a range (4x4-7x7) that contains every width and height between the two sizes.
+  * @param  text  The board sizes
+  * @param  sizes The parsed board sizes are appended to it
+  * @retval true:   All board sizes are valid
+  *         false:  A board size can't be parsed
+  */
+bool LUKPBatch::parseSizes(const std::string& text, std::vector<std::pair<uint8_t, uint8_t>>& sizes) {
+  size_t begin = 0;
+  while(begin <= text.size()) {
+    size_t end = text.find(',', begin);
+    if(end == std::string::npos) end = text.size();
+    std::string item = text.substr(begin, end - begin);
+    begin = end + 1;
+
+    unsigned int m1 = 0, n1 = 0, m2 = 0, n2 = 0;
+    char separator = 0;
+    int count = sscanf(item.c_str(), "%ux%u%c%ux%u", &m1, &n1, &separator, &m2, &n2);
+    if(count == 2) {
+      m2 = m1;
+      n2 = n1;
+    }else if(count != 5 || separator != '-') {
+      return false;
+    }
+    if(m1 == 0 || n1 == 0 || m1 > m2 || n1 > n2 || m2 > 255 || n2 > 255) return false;
+
+    for(unsigned int m = m1; m <= m2; m++) {
+      for(unsigned int n = n1; n <= n2; n++) {
+        sizes.push_back(std::make_pair(m, n));
+      }
+    }
+  }
+  return !sizes.empty();
+}
+
+/**
+  * @brief  Searches all board sizes and prints the table of their results. It is also written to paths/batch.csv
+  *         and the longest path of each board size is exported.
+  * @param  boards The board sizes, sizes that are too small for a closed path are skipped
+  * @retval None
+  */
+void LUKPBatch::run(const std::vector<std::pair<uint8_t, uint8_t>>& boards) {
+  uint32_t hardware_threads = std::thread::hardware_concurrency();
+  if(this->threads > 0 && this->threads < hardware_threads){
+    hardware_threads = this->threads;
+  }
+
+  //The smallest boards are searched first, so their results are complete early
+  std::vector<std::pair<uint8_t, uint8_t>> sorted = boards;
+  std::stable_sort(sorted.begin(), sorted.end(), [](const std::pair<uint8_t, uint8_t>& a, const std::pair<uint8_t, uint8_t>& b) {
+    return a.first * a.second < b.first * b.second;
+  });
+
+  ResultCache cache;
+  if(this->options.cache) {
+    cache.load();
+  }
+
+  //All work units of all board sizes, given as the index of the board size and the index of the start configuration
+  std::vector<std::pair<uint32_t, uint32_t>> units;
+  for(const std::pair<uint8_t, uint8_t>& board : sorted) {
+    if((board.first < 4 || board.second < 4) && (board.first + board.second) < 8) continue;
+
+    std::unique_ptr<Size> size(new Size(board.first, board.second));
+    size->row.width = board.first;
+    size->row.height = board.second;
+    size->algorithmn.setSearchOptions(this->options);
+
+    //A board size with a known result has no work units
+    if(this->options.cache && cache.find(board.first, board.second, this->options, size->row.result)) {
+      size->cached = true;
+      this->sizes.push_back(std::move(size));
+      continue;
+    }
+    ResultCache::Entry smaller;
+    if(this->options.cache) {
+      size->algorithmn.setKnownLength(cache.getKnownLength(board.first, board.second));
+    }
+    if(this->options.cache && cache.findEmbeddable(board.first, board.second, smaller)) {
+      size->algorithmn.setIncumbent(smaller.result.longestPathBoard);
+    }
+    size->input = size->algorithmn.createStartConfigurations(hardware_threads, size->row.result);
+    size->output.resize(size->input.size());
+
+    //The known paths are the first bound for the pruning of each board size
+    size->bestLength = size->algorithmn.getInitialBound(size->row.result);
+    size->remaining = size->input.size();
+    size->iterator.reset(new LUKPIterator(size->input, size->output, this->options, size->bestLength));
+
+    for(uint32_t i = 0; i < size->input.size(); i++) {
+      units.push_back(std::make_pair(this->sizes.size(), i));
+    }
+    this->sizes.push_back(std::move(size));
+  }
+  std::cout << "Searching " << this->sizes.size() << " board sizes with " << units.size() << " start configurations." << std::endl;
+
+  //The progress covers the start configurations of all board sizes
+  ProgressReporter progress;
+  if(this->options.progressInterval > 0) {
+    double estimate = 0;
+    for(std::unique_ptr<Size>& size : this->sizes) {
+      for(const ThreadInputData& data : size->input) {
+        estimate += data.estimate;
+      }
+      if(size->iterator) {
+        size->iterator->enableProgress(&progress);
+      }
+    }
+    progress.start(this->options.progressInterval, units.size(), estimate);
+  }
+
+  //Each worker takes the next work unit, so the units are started in the order of the board sizes
+  auto start = std::chrono::steady_clock::now();
+  tbb::atomic<uint32_t> cursor;
+  cursor = 0;
+  tbb::task_scheduler_init init(this->threads > 0 ? this->threads : tbb::task_scheduler_init::automatic);
+  tbb::simple_partitioner sp;
+  tbb::parallel_for(tbb::blocked_range<int>(0, hardware_threads, 1), [&](const tbb::blocked_range<int>&) {
+    for(uint32_t i = cursor++; i < units.size(); i = cursor++) {
+      Size& size = *this->sizes[units[i].first];
+      (*size.iterator)(tbb::blocked_range<int>(units[i].second, units[i].second + 1, 1));
+
+      //The last work unit of a board size completes it
+      if(--size.remaining == 0) {
+        std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+        size.row.seconds = elapsed_seconds.count();
+        this->seedLarger(units[i].first);
+      }
+    }
+  }, sp);
+  progress.stop();
+
+  std::vector<BatchResult> rows;
+  FileExporter fileExporter;
+  for(std::unique_ptr<Size>& size : this->sizes) {
+    for(const OutputData& out : size->output) {
+      size->row.result += out;
+      size->row.threadSeconds += out.seconds;
+    }
+    fileExporter.exportPath(size->row.result.longestPathBoard, 1);
+    if(this->options.cache && !size->cached) {
+      cache.store(size->row.width, size->row.height, this->options, size->row.result);
+    }
+    rows.push_back(size->row);
+  }
+  fileExporter.exportBatchResults(rows);
+
+  std::cout << "size\tlength\tcount\tseconds\tthread seconds\tnodes" << std::endl;
+  for(const BatchResult& row : rows) {
+    std::cout << (int) row.width << "x" << (int) row.height << "\t" << row.result.longestPathLength << "\t";
+    if(this->options.countPaths) {
+      std::cout << row.result.longestPathCount;
+    }else{
+      std::cout << "-";
+    }
+    std::cout << "\t" << row.seconds << "\t" << row.threadSeconds << "\t" << row.result.nodes << std::endl;
+  }
+}
+
+/**
+  * @brief  Embeds the longest path of a finished board size into the larger board sizes that are still searched.
+  *         If it is longer than their incumbent, it is their new incumbent and raises their bound for the pruning.
+  * @param  index The index of the finished board size
+  * @retval None
+  */
+void LUKPBatch::seedLarger(uint32_t index) {
+  std::lock_guard<std::mutex> lock(this->seeding);
+  Size& finished = *this->sizes[index];
+  OutputData result = finished.row.result;
+  for(const OutputData& out : finished.output) {
+    result += out;
+  }
+  if(result.longestPathLength == 0) return;
+
+  for(size_t i = index + 1; i < this->sizes.size(); i++) {
+    Size& larger = *this->sizes[i];
+    if(larger.cached || larger.remaining == 0 || !larger.algorithmn.setIncumbent(result.longestPathBoard)) continue;
+
+    larger.algorithmn.addIncumbent(larger.row.result);
+    raiseLength(larger.bestLength, larger.algorithmn.getInitialBound(larger.row.result));
+  }
+}
+
+/**
+  * @brief  Raises the bound of the pruning of a board size. The bound is only increased.
+  * @param  bestLength The bound of the board size
+  * @param  length     The new bound
+  * @retval None
+  */
+void LUKPBatch::raiseLength(tbb::atomic<uint16_t>& bestLength, uint16_t length) {
+  uint16_t seen = bestLength;
+  while(length > seen) {
+    uint16_t previous = bestLength.compare_and_swap(length, seen);
+    if(previous == seen) break;
+    seen = previous;
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef LUKPBATCH_H
+#define LUKPBATCH_H
+
+#include "stdint.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+
+#include "tbb/atomic.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/partitioner.h"
+#include "tbb/task_scheduler_init.h"
+
+#include "LUKPData.h"
+#include "LUKPIterator.h"
+#include "LongestUncrossedKnightsPath.h"
+#include "FileExporter.h"
+#include "ResultCache.h"
+#include "SearchOptions.h"
+
+/**
+ * Searches several board sizes in one process. The start configurations of all board sizes are processed by one
+ * thread pool, the smallest board first. Each board size keeps its own bound for the pruning. When a board size
+ * is finished, its longest path is embedded into the larger board sizes that are still searched and raises their bound.
+ * The results are written to one table.
+ */
+class LUKPBatch {
+
+private:
+	/**
+	 * Data class that stores a board size of the batch with its start configurations and results.
+	 */
+	class Size {
+	public:
+		BatchResult row;
+		LongestUncrossedKnightsPath algorithmn;
+		std::vector<ThreadInputData> input;
+		std::vector<OutputData> output;
+		tbb::atomic<uint16_t> bestLength;
+		tbb::atomic<uint32_t> remaining;
+		std::unique_ptr<LUKPIterator> iterator;
+
+		//The result is known from the cache, the board size isn't searched
+		bool cached = false;
+
+		Size(uint8_t m, uint8_t n) : algorithmn(m, n) { }
+	};
+
+	SearchOptions options;
+	uint16_t threads;
+	std::vector<std::unique_ptr<Size>> sizes;
+
+	//Guards the incumbents of the board sizes, they are raised by the board sizes that finish
+	std::mutex seeding;
+
+	void seedLarger(uint32_t);
+	static void raiseLength(tbb::atomic<uint16_t>&, uint16_t);
+
+public:
+	LUKPBatch(const SearchOptions&, uint16_t);
+
+	static bool parseSizes(const std::string&, std::vector<std::pair<uint8_t, uint8_t>>&);
+	void run(const std::vector<std::pair<uint8_t, uint8_t>>&);
+};
+
+#endif /* LUKPBATCH_H */
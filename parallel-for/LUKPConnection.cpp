@@ -0,0 +1,136 @@
+#include "LUKPConnection.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/**
+  * @brief  Constructor of a connection, it takes the ownership of the socket.
+  * @param  _socket The connected socket
+  */
+LUKPConnection::LUKPConnection(int _socket) : socket(_socket) {
+  //A lost peer is detected by the keep alive probes, even if it can't close the connection anymore
+  int enable = 1;
+  setsockopt(this->socket, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable));
+}
+
+/**
+  * @brief  Destructor, closes the socket.
+  */
+LUKPConnection::~LUKPConnection() {
+  close(this->socket);
+}
+
+/**
+  * @brief  Creates a socket that accepts connections on a port of all interfaces.
+  * @param  port The port
+  * @retval The listening socket, -1 on error
+  */
+int LUKPConnection::listenOn(uint16_t port) {
+  int server = ::socket(AF_INET, SOCK_STREAM, 0);
+  if(server < 0) return -1;
+
+  int enable = 1;
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  if(bind(server, (sockaddr*) &address, sizeof(address)) < 0 || listen(server, SOMAXCONN) < 0) {
+    close(server);
+    return -1;
+  }
+  return server;
+}
+
+/**
+  * @brief  Connects to a host.
+  * @param  host The name or address of the host
+  * @param  port The port
+  * @retval The connected socket, -1 on error
+  */
+int LUKPConnection::connectTo(const std::string& host, uint16_t port) {
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo* addresses = nullptr;
+  if(getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) return -1;
+
+  int client = -1;
+  for(addrinfo* address = addresses; address != nullptr && client < 0; address = address->ai_next) {
+    client = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if(client >= 0 && connect(client, address->ai_addr, address->ai_addrlen) < 0) {
+      close(client);
+      client = -1;
+    }
+  }
+  freeaddrinfo(addresses);
+  return client;
+}
+
+int LUKPConnection::getSocket() const {
+  return this->socket;
+}
+
+/**
+  * @brief  Sends a line. The line break is appended.
+  * @param  line The line without line break
+  * @retval true:   The line was sent
+  *         false:  The connection is lost
+  */
+bool LUKPConnection::sendLine(const std::string& line) {
+  std::string message = line + "\n";
+  size_t sent = 0;
+  while(sent < message.size()) {
+    ssize_t count = send(this->socket, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+    if(count <= 0) return false;
+    sent += count;
+  }
+  return true;
+}
+
+/**
+  * @brief  Receives the available data into the buffer. It blocks if no data is available.
+  * @retval true:   Data was received
+  *         false:  The connection is closed or lost
+  */
+bool LUKPConnection::receive() {
+  char data[4096];
+  ssize_t count = recv(this->socket, data, sizeof(data), 0);
+  if(count <= 0) return false;
+  this->buffer.append(data, count);
+  return true;
+}
+
+/**
+  * @brief  Takes the next complete line from the buffer.
+  * @param  line The line without line break
+  * @retval true:   There was a complete line
+  *         false:  The buffer has no complete line
+  */
+bool LUKPConnection::nextLine(std::string& line) {
+  size_t end = this->buffer.find('\n');
+  if(end == std::string::npos) return false;
+  line = this->buffer.substr(0, end);
+  this->buffer.erase(0, end + 1);
+  return true;
+}
+
+/**
+  * @brief  Reads the next line and blocks until it is complete.
+  * @param  line The line without line break
+  * @retval true:   A line was read
+  *         false:  The connection is closed or lost
+  */
+bool LUKPConnection::readLine(std::string& line) {
+  while(!this->nextLine(line)) {
+    if(!this->receive()) return false;
+  }
+  return true;
+}
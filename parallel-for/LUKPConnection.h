@@ -0,0 +1,33 @@
+#ifndef LUKPCONNECTION_H
+#define LUKPCONNECTION_H
+
+#include "stdint.h"
+#include <string>
+
+/**
+ * A TCP connection between the coordinator and a worker. The messages are text lines.
+ * The received data is buffered, so the coordinator can read whatever is available and take the complete lines from the buffer.
+ */
+class LUKPConnection {
+
+private:
+	int socket;
+	std::string buffer;
+
+public:
+	explicit LUKPConnection(int);
+	virtual ~LUKPConnection();
+	LUKPConnection(const LUKPConnection&) = delete;
+	LUKPConnection& operator=(const LUKPConnection&) = delete;
+
+	static int listenOn(uint16_t);
+	static int connectTo(const std::string&, uint16_t);
+
+	int getSocket() const;
+	bool sendLine(const std::string&);
+	bool receive();
+	bool nextLine(std::string&);
+	bool readLine(std::string&);
+};
+
+#endif /* LUKPCONNECTION_H */
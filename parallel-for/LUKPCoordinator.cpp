@@ -0,0 +1,180 @@
+#include "LUKPCoordinator.h"
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+/**
+  * @brief  Constructor of the coordinator.
+  * @param  _port    The port the workers connect to
+  * @param  _options The search options, they are sent to the workers
+  */
+LUKPCoordinator::LUKPCoordinator(uint16_t _port, const SearchOptions& _options) : port(_port), options(_options) { }
+
+/**
+  * @brief  Enables the progress. Each received result is given to the reporter.
+  * @param  _progress The reporter
+  * @retval None
+  */
+void LUKPCoordinator::enableProgress(ProgressReporter* _progress) {
+  this->progress = _progress;
+}
+
+/**
+  * @brief  Enables the deadline. The coordinator stops waiting for results when it is expired,
+  *         the workers finish their current start configuration and get no new ones.
+  * @param  _anytime The deadline of the search
+  * @retval None
+  */
+void LUKPCoordinator::enableDeadline(AnytimeSearch* _anytime) {
+  this->anytime = _anytime;
+}
+
+/**
+  * @brief  Distributes all start configurations and waits until the results of all of them are received.
+  * @param  input      The start configurations
+  * @param  output     The outputs, one per start configuration
+  * @param  finished   The flags of the finished start configurations
+  * @param  longestPathLength The longest path length known before, it is sent to the workers as bound for the pruning
+  * @retval true:   All start configurations are finished or the deadline is expired
+  *         false:  The port can't be opened
+  */
+bool LUKPCoordinator::run(std::vector<ThreadInputData>& input, std::vector<OutputData>& output, std::vector<std::atomic<bool>>& finished, uint16_t longestPathLength) {
+  int server = LUKPConnection::listenOn(this->port);
+  if(server < 0) {
+    std::cerr << "Can't listen on port " << this->port << "." << std::endl;
+    return false;
+  }
+  std::cout << "Waiting for workers on port " << this->port << "." << std::endl;
+
+  this->bestLength = longestPathLength;
+  for(uint32_t i = 0; i < input.size(); i++) {
+    this->pending.push_back(i);
+  }
+
+  std::vector<Worker> workers;
+  while(this->finishedCount < input.size() && !(this->anytime != nullptr && this->anytime->isExpired())) {
+    std::vector<pollfd> sockets;
+    sockets.push_back({server, POLLIN, 0});
+    for(Worker& worker : workers) {
+      sockets.push_back({worker.connection->getSocket(), POLLIN, 0});
+    }
+    //With a deadline the loop wakes up every second to check it
+    if(poll(sockets.data(), sockets.size(), this->anytime != nullptr ? 1000 : -1) < 0) continue;
+
+    //Handle the messages of the known workers before new ones are added
+    for(size_t i = 0; i + 1 < sockets.size(); i++) {
+      if(sockets[i + 1].revents == 0) continue;
+
+      Worker& worker = workers[i];
+      std::string line;
+      bool alive = worker.connection->receive();
+      while(alive && worker.connection->nextLine(line)) {
+        alive = this->handle(worker, line, input, output, finished);
+      }
+
+      //The start configuration of a lost worker is given to the next idle one
+      if(!alive) {
+        if(worker.unit >= 0) {
+          this->pending.push_front(worker.unit);
+          std::cout << "Lost a worker, start configuration " << worker.unit << " is reassigned." << std::endl;
+        }
+        worker.connection.reset();
+      }
+    }
+
+    //Remove the lost workers and give the reassigned start configurations to idle ones
+    for(size_t i = workers.size(); i-- > 0;) {
+      if(!workers[i].connection) workers.erase(workers.begin() + i);
+    }
+    for(Worker& worker : workers) {
+      if(worker.ready && worker.unit < 0 && !this->pending.empty() && !this->assign(worker, input)) {
+        this->pending.push_front(worker.unit);
+        worker.unit = -1;
+      }
+    }
+
+    if(sockets[0].revents & POLLIN) {
+      int socket = accept(server, nullptr, nullptr);
+      if(socket >= 0) {
+        Worker worker;
+        worker.connection.reset(new LUKPConnection(socket));
+        workers.push_back(std::move(worker));
+      }
+    }
+  }
+
+  for(Worker& worker : workers) {
+    worker.connection->sendLine("DONE");
+  }
+  close(server);
+  return true;
+}
+
+/**
+  * @brief  Handles a message of a worker.
+  * @param  worker   The worker that sent the message
+  * @param  line     The message
+  * @param  input    The start configurations
+  * @param  output   The outputs, one per start configuration
+  * @param  finished The flags of the finished start configurations
+  * @retval true:   The worker is still connected
+  *         false:  The connection to the worker is lost
+  */
+bool LUKPCoordinator::handle(Worker& worker, const std::string& line, std::vector<ThreadInputData>& input, std::vector<OutputData>& output, std::vector<std::atomic<bool>>& finished) {
+  std::istringstream message(line);
+  std::string type;
+  message >> type;
+
+  if(type == "HELLO") {
+    std::ostringstream options;
+    options << "OPTIONS ";
+    LUKPSerializer::writeOptions(options, this->options);
+    worker.ready = true;
+    return worker.connection->sendLine(options.str()) && this->assign(worker, input);
+  }
+
+  if(type == "RESULT") {
+    int64_t index = -1;
+    message >> index;
+    if(index != worker.unit) return false;
+
+    output[index] = LUKPSerializer::readOutput(message);
+    finished[index] = true;
+    this->finishedCount++;
+    if(output[index].longestPathLength > this->bestLength) {
+      this->bestLength = output[index].longestPathLength;
+    }
+    if(this->anytime != nullptr) {
+      this->anytime->finishUnit();
+    }
+    if(this->progress != nullptr) {
+      this->progress->finishUnit(output[index].nodes, input[index].estimate);
+      this->progress->mergeLongest(output[index].longestPathLength, output[index].longestPathCount);
+    }
+
+    worker.unit = -1;
+    return this->assign(worker, input);
+  }
+
+  return false;
+}
+
+/**
+  * @brief  Sends the next pending start configuration to an idle worker. The worker stays idle if there is none.
+  * @param  worker The idle worker
+  * @param  input  The start configurations
+  * @retval true:   The start configuration was sent or there is none
+  *         false:  The connection to the worker is lost
+  */
+bool LUKPCoordinator::assign(Worker& worker, std::vector<ThreadInputData>& input) {
+  if(this->pending.empty()) return true;
+
+  worker.unit = this->pending.front();
+  this->pending.pop_front();
+
+  std::ostringstream message;
+  message << "UNIT " << worker.unit << " " << this->bestLength << " ";
+  LUKPSerializer::writeInput(message, input[worker.unit]);
+  return worker.connection->sendLine(message.str());
+}
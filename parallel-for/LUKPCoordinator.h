@@ -0,0 +1,62 @@
+#ifndef LUKPCOORDINATOR_H
+#define LUKPCOORDINATOR_H
+
+#include "stdint.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+
+#include "LUKPData.h"
+#include "LUKPConnection.h"
+#include "LUKPSerializer.h"
+#include "SearchOptions.h"
+#include "ProgressReporter.h"
+#include "AnytimeSearch.h"
+
+/**
+ * Distributes the start configurations to worker processes over TCP and collects their results.
+ * Each connection of a worker gets one start configuration at a time. If a connection is lost,
+ * its start configuration is given to the next idle connection. Workers can join at any time.
+ *
+ * Messages (one line each):
+ *   worker -> coordinator: HELLO, RESULT <index> <output>
+ *   coordinator -> worker: OPTIONS <options>, UNIT <index> <longest length> <input>, DONE
+ */
+class LUKPCoordinator {
+
+private:
+	/**
+	 * Data class that stores a connection of a worker and the start configuration it is processing (-1 if idle).
+	 */
+	class Worker {
+	public:
+		std::unique_ptr<LUKPConnection> connection;
+		bool ready = false;
+		int64_t unit = -1;
+	};
+
+	uint16_t port;
+	const SearchOptions& options;
+
+	std::deque<uint32_t> pending;
+	uint32_t finishedCount = 0;
+	uint16_t bestLength = 0;
+	ProgressReporter* progress = nullptr;
+	AnytimeSearch* anytime = nullptr;
+
+	bool handle(Worker&, const std::string&, std::vector<ThreadInputData>&, std::vector<OutputData>&, std::vector<std::atomic<bool>>&);
+	bool assign(Worker&, std::vector<ThreadInputData>&);
+
+public:
+	LUKPCoordinator(uint16_t, const SearchOptions&);
+
+	void enableProgress(ProgressReporter*);
+	void enableDeadline(AnytimeSearch*);
+
+	bool run(std::vector<ThreadInputData>&, std::vector<OutputData>&, std::vector<std::atomic<bool>>&, uint16_t);
+};
+
+#endif /* LUKPCOORDINATOR_H */
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "Chessboard.h"
+#include "PruningStats.h"
 
 /**
  * Data class that stores the information for a parallel instance to start with the backtracking of a subtree.
@@ -13,18 +14,61 @@
 class ThreadInputData {
 public:
 	Chessboard cboard;
-	std::pair<uint8_t, uint8_t> source;
+	uint16_t source;
 	uint8_t incomming_move = 0;
+
+	//The estimated number of nodes of the subtree, 0 if it isn't estimated
+	double estimate = 0;
 };
 
+//The size of a cache line, the outputs of neighbouring instances are aligned to it
+#define CACHE_LINE_SIZE 64
+
 /**
  * Data class that store the calcuation results of a parallel instance that calculates a subtree.
+ * Each output starts on its own cache line, so instances that write their neighbouring outputs don't share a line.
  */
-class OutputData {
+class alignas(CACHE_LINE_SIZE) OutputData {
 public:
 	uint16_t longestPathLength = 0;
 	uint16_t longestPathCount = 0;
 	Chessboard longestPathBoard;
+	PruningStats reachabilityStats;
+
+	//The time the backtracking of the subtree took and the number of nodes it visited
+	double seconds = 0;
+	uint64_t nodes = 0;
+
+	//The number of paths with at least the minimum length, see SearchOptions::minLength
+	uint64_t witnessCount = 0;
+
+	OutputData& operator+=(const OutputData& other) {
+		this->reachabilityStats += other.reachabilityStats;
+		this->nodes += other.nodes;
+		this->witnessCount += other.witnessCount;
+		if(other.longestPathLength == this->longestPathLength){
+			this->longestPathCount += other.longestPathCount;
+		}else if(other.longestPathLength > this->longestPathLength){
+			this->longestPathLength = other.longestPathLength;
+			this->longestPathCount = other.longestPathCount;
+			this->longestPathBoard = other.longestPathBoard;
+		}
+		return *this;
+	}
+};
+
+/**
+ * Data class that stores the final result of a board size of the batch mode.
+ */
+class BatchResult {
+public:
+	uint8_t width = 0;
+	uint8_t height = 0;
+	OutputData result;
+
+	//The time from the start of the batch until the board size was complete and the time its start configurations took in sum
+	double seconds = 0;
+	double threadSeconds = 0;
 };
 
 #endif /* DATA_H */
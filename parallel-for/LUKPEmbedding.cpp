@@ -0,0 +1,134 @@
+#include "LUKPEmbedding.h"
+
+/**
+  * @brief  Checks whether a board fits into another one, as it is or transposed.
+  * @param  width   The width of the smaller board
+  * @param  height  The height of the smaller board
+  * @param  m       The width of the larger board
+  * @param  n       The height of the larger board
+  * @retval true:   The board fits
+  *         false:  The board is larger in one direction
+  */
+bool LUKPEmbedding::fits(uint8_t width, uint8_t height, uint8_t m, uint8_t n) {
+  return (width <= m && height <= n) || (height <= m && width <= n);
+}
+
+/**
+  * @brief  Embeds the path of a board into an empty board of at least the same size. The offsets are tried
+  *         in order until the path can be set without a crossing.
+  * @param  path   The board with the closed path
+  * @param  cboard The empty board, it contains the path if it could be embedded
+  * @retval true:   The path was embedded
+  *         false:  The board doesn't fit or the path is no valid closed path
+  */
+bool LUKPEmbedding::embed(const Chessboard& path, Chessboard& cboard) {
+  if(path.getLength() < 3 || !fits(path.getWidth(), path.getHeight(), cboard.getWidth(), cboard.getHeight())) {
+    return false;
+  }
+
+  std::vector<std::pair<uint8_t, uint8_t>> fields = getFields(path);
+  for(int transposed = 0; transposed < 2; transposed++) {
+    uint8_t width = transposed ? path.getHeight() : path.getWidth();
+    uint8_t height = transposed ? path.getWidth() : path.getHeight();
+    if(width > cboard.getWidth() || height > cboard.getHeight()) continue;
+
+    for(uint8_t dy = 0; dy <= cboard.getHeight() - height; dy++) {
+      for(uint8_t dx = 0; dx <= cboard.getWidth() - width; dx++) {
+        std::vector<std::pair<uint8_t, uint8_t>> moved;
+        for(const std::pair<uint8_t, uint8_t>& field : fields) {
+          uint8_t x = transposed ? field.second : field.first;
+          uint8_t y = transposed ? field.first : field.second;
+          moved.push_back(std::make_pair(x + dx + BORDER_OFFSET, y + dy + BORDER_OFFSET));
+        }
+
+        Chessboard cpy = cboard;
+        if(place(moved, cpy)) {
+          cboard = cpy;
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/**
+  * @brief  Returns the fields of a closed path in order, starting at the root.
+  * @param  cboard The board with the closed path
+  * @retval The fields without the border offset
+  */
+std::vector<std::pair<uint8_t, uint8_t>> LUKPEmbedding::getFields(Chessboard cboard) {
+  std::vector<std::pair<uint8_t, uint8_t>> fields;
+  uint16_t root = cboard.getRootIndex();
+  uint16_t current = root;
+  uint8_t previous = 0;
+  do {
+    uint8_t next = 0;
+    for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
+      if((cboard.at(current) & move) != 0 && (previous == 0 || move != cboard.rotate180(previous))) {
+        next = move;
+        break;
+      }
+    }
+    std::pair<uint8_t, uint8_t> field = cboard.toField(current);
+    fields.push_back(std::make_pair(field.first - BORDER_OFFSET, field.second - BORDER_OFFSET));
+    current = cboard.doMove(current, next);
+    previous = next;
+  } while(previous != 0 && current != root && fields.size() <= cboard.getLength());
+  return fields;
+}
+
+/**
+  * @brief  Returns the move between two fields.
+  * @param  from The field the move starts on
+  * @param  to   The field the move ends on
+  * @retval The move, 0 if the fields aren't a knight move apart
+  */
+uint8_t LUKPEmbedding::getMove(std::pair<uint8_t, uint8_t> from, std::pair<uint8_t, uint8_t> to) {
+  int dx = to.first - from.first;
+  int dy = to.second - from.second;
+  for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+    if(MoveTable::moveDx[i] == dx && MoveTable::moveDy[i] == dy) {
+      return 1 << i;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Sets a closed path move by move like the backtracking: every field needs to be free and no move
+  *         may cross the path before it, the last move needs to finish the path at the root.
+  * @param  fields The fields of the path with the border offset
+  * @param  cboard The empty board
+  * @retval true:   The path was set
+  *         false:  A field is used twice, is outside of the board or a move crosses the path
+  */
+bool LUKPEmbedding::place(const std::vector<std::pair<uint8_t, uint8_t>>& fields, Chessboard& cboard) {
+  std::vector<uint8_t> moves;
+  for(size_t i = 0; i < fields.size(); i++) {
+    moves.push_back(getMove(fields[i], fields[(i + 1) % fields.size()]));
+    if(moves.back() == 0) return false;
+  }
+  if(moves.size() < 3 || cboard.isFieldReserved(fields[0])) return false;
+
+  cboard.setRoot(moves[0], fields[0]);
+  uint16_t source = cboard.doMove(cboard.getRootIndex(), moves[0]);
+  uint8_t incoming_move = moves[0];
+  for(size_t i = 1; i < moves.size(); i++) {
+    uint8_t outgoing_move = moves[i];
+    uint16_t target = cboard.doMove(source, outgoing_move);
+
+    if(i + 1 < moves.size()) {
+      if(cboard.isFieldReserved(target) || cboard.isConnectionCrossesEdge(source, outgoing_move)) return false;
+      cboard.setField(outgoing_move | cboard.rotate180(incoming_move), source);
+    }else{
+      if(!cboard.isFinishable(source, target, outgoing_move)) return false;
+      uint16_t root = cboard.getRootIndex();
+      cboard.setField(outgoing_move | cboard.rotate180(incoming_move), source);
+      cboard.updateField(cboard.at(root) | cboard.rotate180(outgoing_move), root);
+    }
+    source = target;
+    incoming_move = outgoing_move;
+  }
+  return true;
+}
@@ -0,0 +1,26 @@
+#ifndef LUKPEMBEDDING_H
+#define LUKPEMBEDDING_H
+
+#include "stdint.h"
+#include <vector>
+
+#include "Chessboard.h"
+#include "MoveTable.h"
+
+/**
+ * Embeds the closed path of a smaller board into a larger one. A path of an (m-1)xn or mx(n-1) board is also a path
+ * of the mxn board, so it is a lower bound of the longest length there. The path is moved to every offset (and
+ * transposed, if it only fits this way) and set move by move with the crossing checks of the backtracking.
+ */
+class LUKPEmbedding {
+private:
+	static std::vector<std::pair<uint8_t, uint8_t>> getFields(Chessboard);
+	static uint8_t getMove(std::pair<uint8_t, uint8_t>, std::pair<uint8_t, uint8_t>);
+	static bool place(const std::vector<std::pair<uint8_t, uint8_t>>&, Chessboard&);
+
+public:
+	static bool fits(uint8_t, uint8_t, uint8_t, uint8_t);
+	static bool embed(const Chessboard&, Chessboard&);
+};
+
+#endif /* LUKPEMBEDDING_H */
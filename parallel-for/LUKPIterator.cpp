@@ -4,52 +4,253 @@
   * @brief  The constuctor for the class that is used in the tbb parallel_for loop.
   * @param  input   The input data that the parallel instances can access to start their calculatons
   * @param  output  The output data that the parallel instances can access to store their results
+  * @param  options The options that select how the backtracking is executed
+  * @param  bestLength The longest path length that is shared by all parallel instances
   */
-LUKPIterator::LUKPIterator(std::vector<ThreadInputData>& _input, std::vector<OutputData>& _output) : input(_input), output(_output){ }
+LUKPIterator::LUKPIterator(std::vector<ThreadInputData>& _input, std::vector<OutputData>& _output, const SearchOptions& _options, tbb::atomic<uint16_t>& _bestLength) : input(_input), output(_output), options(_options), bestLength(_bestLength){ }
 
 /**
   * @brief  The method that is called by the parallel_for loop for a provided range.
   *         The values of this range get caculated sequential in its parallel instance.
   *         For each item in the range a backtracking is started for the given start configuration (provided by the input array).
-  * @param  r The range that represents the items in the input array.
+  *         With the ordered dispatch the range only represents the workers. Each worker takes the next start configuration of
+  *         the input array until all are taken, so they are started in the order of the array.
+  * @param  r The range that represents the items in the input array, or the workers with the ordered dispatch.
   * @retval None
   */
 void LUKPIterator::operator()(const tbb::blocked_range<int>& r) const{
+	if(cursor != nullptr){
+		for(uint32_t i = (*cursor)++; i < input.size(); i = (*cursor)++){
+			startTimed(i);
+		}
+		return;
+	}
+
 	for (int i = r.begin(); i != r.end(); i++){
-		ThreadInputData data = input[i];
+		startTimed(i);
+	}
+}
+
+/**
+  * @brief  Starts the backtracking for an item of the input array and stores the time it took in its output.
+  *         With the checkpoints the item is marked as finished after its output is complete.
+  * @param  i The index of the item
+  * @retval None
+  */
+void LUKPIterator::startTimed(int i) const{
+	auto begin = std::chrono::steady_clock::now();
+	ThreadInputData data = input[i];
+	start(data, &output[i]);
+	std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - begin;
+	output[i].seconds = elapsed_seconds.count();
+
+	//A start configuration that was stopped by the deadline isn't finished, it is searched again when the search is resumed
+	if(isExpired()){
+		return;
+	}
+	if(anytime != nullptr){
+		anytime->finishUnit();
+	}
+	if(finished != nullptr){
+		(*finished)[i] = true;
+	}
+	if(progress != nullptr){
+		progress->finishUnit(output[i].nodes, input[i].estimate);
+		progress->mergeLongest(output[i].longestPathLength, output[i].longestPathCount);
+	}
+}
+
+/**
+  * @brief  The method that is called by the parallel_do loop of the dynamic splitting for each start configuration in the pool.
+  *         The results are stored per thread, because the number of start configurations isn't known up front.
+  * @param  data   The start configuration
+  * @param  feeder The feeder to give subtrees back to the pool
+  * @retval None
+  */
+void LUKPIterator::operator()(ThreadInputData& data, tbb::parallel_do_feeder<ThreadInputData>& feeder) const{
+	(*pending)--;
+
+	//The feeder belongs to this call, so it is stored in a copy of the iterator
+	LUKPIterator worker(*this);
+	worker.feeder = &feeder;
+	OutputData* out = &results->local();
+	uint64_t nodes = out->nodes;
+	worker.start(data, out);
+
+	//The paths are merged per thread, so the progress only gets the nodes of the start configuration
+	if(progress != nullptr){
+		progress->finishUnit(out->nodes - nodes, 0);
+	}
+	if(anytime != nullptr && !isExpired()){
+		anytime->finishUnit();
+	}
+}
+
+/**
+  * @brief  Enables the dynamic splitting. The iterator then needs to be run by a parallel_do loop.
+  * @param  _results  The results per thread
+  * @param  _pending  The number of start configurations that wait in the pool
+  * @param  _threads  The number of threads
+  * @retval None
+  */
+void LUKPIterator::enableSplitting(tbb::combinable<OutputData>* _results, tbb::atomic<uint32_t>* _pending, uint32_t _threads){
+	this->results = _results;
+	this->pending = _pending;
+	this->threads = _threads;
+}
+
+/**
+  * @brief  Enables the ordered dispatch. The iterator then needs to be run over a range of workers.
+  * @param  _cursor  The index of the next start configuration, it needs to start at 0
+  * @retval None
+  */
+void LUKPIterator::enableOrderedDispatch(tbb::atomic<uint32_t>* _cursor){
+	this->cursor = _cursor;
+}
+
+/**
+  * @brief  Enables the checkpoints. Each finished start configuration is marked in the given flags.
+  * @param  _finished  The flags of the finished start configurations, one per item of the input array
+  * @retval None
+  */
+void LUKPIterator::enableCheckpoints(std::vector<std::atomic<bool>>* _finished){
+	this->finished = _finished;
+}
+
+/**
+  * @brief  Enables the progress. Each finished start configuration is given to the reporter.
+  * @param  _progress  The reporter
+  * @retval None
+  */
+void LUKPIterator::enableProgress(ProgressReporter* _progress){
+	this->progress = _progress;
+}
+
+/**
+  * @brief  Enables the deadline. The backtracking stops when it is expired and the new longest paths are offered to it.
+  * @param  _anytime  The deadline of the search
+  * @retval None
+  */
+void LUKPIterator::enableDeadline(AnytimeSearch* _anytime){
+	this->anytime = _anytime;
+}
+
+/**
+  * @brief  Checks whether the deadline of the search is expired.
+  * @retval true:   The search needs to stop
+  *         false:  There is no deadline or it isn't expired
+  */
+bool LUKPIterator::isExpired() const{
+	return anytime != nullptr && anytime->isExpired();
+}
+
+/**
+  * @brief  Starts the backtracking for a start configuration.
+  * @param  data  The start configuration
+  * @param  out   A reference to the output object to store the results within the current instance
+  * @retval None
+  */
+void LUKPIterator::start(ThreadInputData& data, OutputData* out) const{
+	//Board sizes with a specialised kernel use the FixedChessboard, it has the same field numbering as the chessboard
+	if(options.specialised && startSpecialised(data, out)){
+		return;
+	}
+
+	//Boards with at most 64 fields are converted to a bitboard for the backtracking of the subtree
+	if(options.bitboard && Bitboard::fits(data.cboard.getWidth(), data.cboard.getHeight())){
+		//The source is stored as chessboard field index and needs to be converted to the bitboard numbering
+		Bitboard bboard(data.cboard);
+		startBacktracking(bboard, bboard.toIndex(data.cboard.toField(data.source)), data.incomming_move, out);
+	}else{
 		Chessboard cpy = data.cboard;
+		startBacktracking(cpy, data.source, data.incomming_move, out);
+	}
+}
 
-		backtracking(cpy, data.source, data.incomming_move, &output[i]);
+/**
+  * @brief  Starts the backtracking of a subtree with the kernel that is specialised for the board size.
+  * @param  data  The start configuration
+  * @param  out   A reference to the output object to store the results within the current instance
+  * @retval true:   There is a specialised kernel for the board size and the backtracking is done
+  *         false:  There is no specialised kernel, the generic one needs to be used
+  */
+bool LUKPIterator::startSpecialised(ThreadInputData& data, OutputData* out) const{
+	switch(FIXED_CHESSBOARD_KEY(data.cboard.getWidth(), data.cboard.getHeight())){
+#define START_SPECIALISED(W, H) \
+		case FIXED_CHESSBOARD_KEY(W, H): { \
+			FixedChessboard<W, H> fboard(data.cboard); \
+			startBacktracking(fboard, data.source, data.incomming_move, out); \
+			return true; \
+		}
+		FIXED_CHESSBOARD_SIZES(START_SPECIALISED)
+#undef START_SPECIALISED
+		default:
+			return false;
+	}
+}
+
+/**
+  * @brief  Starts the backtracking of a subtree with the variant selected in the search options.
+  * @param  cboard        The chessboard of the start configuration
+  * @param  source        The field index of the current field
+  * @param  incoming_move The current move that leads to source
+  * @param  out           A reference to the output object to store the results within the current instance
+  * @retval None
+  */
+template<typename Board>
+void LUKPIterator::startBacktracking(Board &cboard, uint16_t source, uint8_t incoming_move, OutputData* out) const{
+	if(options.inPlace){
+		backtrackingInPlace(cboard, source, incoming_move, out);
+	}else{
+		backtracking(cboard, source, incoming_move, out);
 	}
 }
 
 /**
   * @brief  The actual bactracking. In each iteration a node is processed.
   * @param  cboard        The current copy of the chessboard
-  * @param  source        The current field
+  * @param  source        The field index of the current field
   * @param  incoming_move The current move that leads to source
   * @param  out           A reference to the output object to store the results within the current instance
   * @retval None
   */
-void LUKPIterator::backtracking(Chessboard &cboard, std::pair<uint8_t, uint8_t> source, uint8_t incoming_move, OutputData* out) const{
-  for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
-    std::pair<uint8_t, uint8_t> target = cboard.doMove(source, outgoing_move);
+template<typename Board>
+void LUKPIterator::backtracking(Board &cboard, uint16_t source, uint8_t incoming_move, OutputData* out) const{
+  out->nodes++;
+  if(isExpired()){
+    return;
+  }
+  if(options.bound && isPrunable(cboard, source)){
+    return;
+  }
+  if(options.reachability > 0 && isDisconnected(cboard, source, out)){
+    return;
+  }
 
-    if(!cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(source, outgoing_move)) {
+  //Only the open moves are processed, lowest bit first. A move to the root is open if it doesn't cross an edge.
+  for(uint8_t open = cboard.getOpenMoves(source); open != 0; open &= open - 1) {
+    uint8_t outgoing_move = open & -open;
+    uint16_t target = cboard.doMove(source, outgoing_move);
+
+    if(target != cboard.getRootIndex()) {
       //The next move is valid, so it gets stored in a new board copy
       uint8_t moves = outgoing_move | cboard.rotate180(incoming_move);
-      Chessboard cpy = cboard;
+      Board cpy = cboard;
       cpy.setField(moves, source);
 
-      //The next backtracking iteration with the new move and target node gets started
-      this->backtracking(cpy, target, outgoing_move, out);
-    }else if(cboard.isFinishable(source, target, outgoing_move)) {
+      //The next backtracking iteration with the new move and target node gets started, or given to an idle thread
+      if(isSplittable(cpy)){
+        split(cpy, target, outgoing_move);
+      }else{
+        this->backtracking(cpy, target, outgoing_move, out);
+      }
+    }else if(isCanonicalClosing(cboard, outgoing_move)) {
       //The board can be finised. The finishing move gets stored in a new board copy
       uint8_t moves = outgoing_move | cboard.rotate180(incoming_move);
-      Chessboard cpy = cboard;
-      std::pair<uint8_t, uint8_t> root = cpy.getRoot();
+      Board cpy = cboard;
+      uint16_t root = cpy.getRootIndex();
       cpy.setField(moves, source);
-      cpy.updateField((cpy.at(root.first, root.second) | cboard.rotate180(outgoing_move)), root);
+      cpy.updateField((cpy.at(root) | cboard.rotate180(outgoing_move)), root);
 
       //Check if the completed path is of an important length
       if(cpy.getLength() == out->longestPathLength){
@@ -57,9 +258,238 @@ void LUKPIterator::backtracking(Chessboard &cboard, std::pair<uint8_t, uint8_t>
       }else if(cpy.getLength() > out->longestPathLength){
         out->longestPathLength = cpy.getLength();
         out->longestPathCount = 1;
-        out->longestPathBoard = cpy;
+        out->longestPathBoard = static_cast<Chessboard>(cpy);
+        publishLength(out->longestPathLength);
+        offerPath(out);
       }
-    } 
-    //else { Field is used or crosses path -> do nothing}
+      checkWitness(cpy.getLength(), out);
+    }
   }
 }
+
+/**
+  * @brief  The in-place variant of the backtracking. Instead of copying the chessboard for every valid move,
+  *         the move is set on the given board and reverted after the subtree was processed.
+  *         Each parallel instance works on its own board, so no synchronization is needed.
+  * @param  cboard        The chessboard of the current parallel instance
+  * @param  source        The field index of the current field
+  * @param  incoming_move The current move that leads to source
+  * @param  out           A reference to the output object to store the results within the current instance
+  * @retval None
+  * @see    backtracking()
+  */
+template<typename Board>
+void LUKPIterator::backtrackingInPlace(Board &cboard, uint16_t source, uint8_t incoming_move, OutputData* out) const{
+  out->nodes++;
+  if(isExpired()){
+    return;
+  }
+  if(options.bound && isPrunable(cboard, source)){
+    return;
+  }
+  if(options.reachability > 0 && isDisconnected(cboard, source, out)){
+    return;
+  }
+
+  uint8_t incoming = cboard.rotate180(incoming_move);
+
+  //Only the open moves are processed, lowest bit first. A move to the root is open if it doesn't cross an edge.
+  for(uint8_t open = cboard.getOpenMoves(source); open != 0; open &= open - 1) {
+    uint8_t outgoing_move = open & -open;
+    uint16_t target = cboard.doMove(source, outgoing_move);
+
+    if(target != cboard.getRootIndex()) {
+      //The next move is valid, so it gets stored on the board until the subtree is processed
+      cboard.setField(outgoing_move | incoming, source);
+      if(isSplittable(cboard)){
+        split(cboard, target, outgoing_move);
+      }else{
+        this->backtrackingInPlace(cboard, target, outgoing_move, out);
+      }
+      cboard.unsetField(source);
+    }else if(isCanonicalClosing(cboard, outgoing_move)) {
+      //The board can be finised. The finishing move is set temporarily to check and store the path.
+      uint16_t root = cboard.getRootIndex();
+      uint8_t rootMoves = cboard.at(root);
+      cboard.setField(outgoing_move | incoming, source);
+      cboard.updateField(rootMoves | cboard.rotate180(outgoing_move), root);
+
+      //Check if the completed path is of an important length
+      if(cboard.getLength() == out->longestPathLength){
+        out->longestPathCount++;
+      }else if(cboard.getLength() > out->longestPathLength){
+        out->longestPathLength = cboard.getLength();
+        out->longestPathCount = 1;
+        out->longestPathBoard = static_cast<Chessboard>(cboard);
+        publishLength(out->longestPathLength);
+        offerPath(out);
+      }
+      checkWitness(cboard.getLength(), out);
+
+      cboard.updateField(rootMoves, root);
+      cboard.unsetField(source);
+    }
+  }
+}
+
+/**
+  * @brief  Checks whether the subtree of a node is given back to the pool. This is the case with the dynamic splitting,
+  *         if the path is shorter than the split depth and less start configurations are waiting than there are threads.
+  * @param  cboard  The current chessboard with the move to the next node set
+  * @retval true:   The subtree is given back to the pool
+  *         false:  The subtree is processed by this worker
+  */
+template<typename Board>
+bool LUKPIterator::isSplittable(Board &cboard) const{
+  return cboard.getLength() < options.splitDepth && feeder != nullptr && *pending < threads;
+}
+
+/**
+  * @brief  Gives the subtree of a node back to the pool as new start configuration.
+  * @param  cboard        The current chessboard with the move to the next node set
+  * @param  source        The field index of the next node
+  * @param  incoming_move The move that leads to source
+  * @retval None
+  */
+template<typename Board>
+void LUKPIterator::split(Board &cboard, uint16_t source, uint8_t incoming_move) const{
+  ThreadInputData data;
+  data.cboard = static_cast<Chessboard>(cboard);
+  data.source = data.cboard.toIndex(cboard.toField(source));
+  data.incomming_move = incoming_move;
+
+  (*pending)++;
+  if(progress != nullptr){
+    progress->addUnits(1);
+  }
+  if(anytime != nullptr){
+    anytime->addUnits(1);
+  }
+  feeder->add(data);
+}
+
+/**
+  * @brief  The length that a path needs to reach to be searched further: the longest path length of all parallel instances,
+  *         or the next longer length if the paths aren't counted. With a minimum length it is the minimum length instead.
+  * @param  None
+  * @retval The length limit of the branch and bound
+  */
+uint16_t LUKPIterator::getBoundLimit() const{
+  uint16_t best = bestLength;
+  uint16_t limit = options.countPaths ? best : best + 1;
+  if(options.minLength > 0){
+    limit = options.minLength;
+  }
+  //A closed path alternates between the two field colors, so its length is even
+  return limit + (limit & 1);
+}
+
+/**
+  * @brief  Checks whether the subtree of a node can be pruned. The path can at most be extended by the free fields
+  *         that are reachable from source over open moves, so the current length plus their number is an upper bound
+  *         for its length. If the root can't be reached anymore, the path can't be closed at all, see Chessboard::countReachable().
+  *         The bound is the longest path length of all parallel instances, with a minimum length it is the minimum length instead.
+  *         The check runs every BOUND_INTERVAL plies.
+  * @param  cboard  The current chessboard
+  * @param  source  The field index of the current field
+  * @retval true:   The subtree can't beat the longest path (or reach its length, if the paths are counted)
+  *         false:  The subtree needs to be processed
+  */
+template<typename Board>
+bool LUKPIterator::isPrunable(Board &cboard, uint16_t source) const{
+  uint16_t limit = getBoundLimit();
+  if(cboard.getLength() % BOUND_INTERVAL != 0 || cboard.getLength() + 1 >= limit){
+    return false;
+  }
+
+  uint16_t needed = limit - cboard.getLength();
+  return cboard.countReachable(source, needed) < needed;
+}
+
+/**
+  * @brief  Checks every k plies whether the path can still return to the root. If it can't, the subtree is cut.
+  *         The counters are stored in the output of the current instance, so no synchronization is needed.
+  *         If the bound of -p was checked on this ply, it already covers the root, so it isn't searched twice.
+  * @param  cboard  The current chessboard
+  * @param  source  The field index of the current field
+  * @param  out     A reference to the output object to store the results within the current instance
+  * @retval true:   The root can't be reached anymore, the subtree can be pruned
+  *         false:  The subtree needs to be processed
+  */
+template<typename Board>
+bool LUKPIterator::isDisconnected(Board &cboard, uint16_t source, OutputData* out) const{
+  if(cboard.getLength() % options.reachability != 0){
+    return false;
+  }
+  if(options.bound && cboard.getLength() % BOUND_INTERVAL == 0 && cboard.getLength() + 1 < getBoundLimit()){
+    return false;
+  }
+
+  bool disconnected = !cboard.isRootReachable(source);
+  out->reachabilityStats.checked++;
+  out->reachabilityStats.pruned += disconnected;
+  return disconnected;
+}
+
+/**
+  * @brief  In the canonical mode each cycle is only accepted in one direction: the move that closes the cycle
+  *         needs to be a larger move of the root than the first move. Otherwise every closing move is accepted.
+  * @param  cboard        The current chessboard
+  * @param  outgoing_move The move that closes the cycle
+  * @retval true:   The cycle is accepted
+  *         false:  The cycle is found in the other direction
+  */
+template<typename Board>
+bool LUKPIterator::isCanonicalClosing(Board &cboard, uint8_t outgoing_move) const{
+  return !options.canonical || cboard.rotate180(outgoing_move) > cboard.at(cboard.getRootIndex());
+}
+
+/**
+  * @brief  Writes a new longest path of the current instance to the file of the longest path so far, if the search has a deadline.
+  * @param  out  The output of the current instance with the new longest path
+  * @retval None
+  */
+void LUKPIterator::offerPath(const OutputData* out) const{
+	if(anytime != nullptr && options.deadline > 0){
+		anytime->offerPath(out->longestPathBoard);
+	}
+}
+
+/**
+  * @brief  Counts a closed path in the output of the current instance if it has at least the minimum length.
+  *         Without counting the witnesses, the first one stops all instances. Every path of the instance before it is shorter,
+  *         so the witness is the longest path of its output.
+  * @param  length The length of the closed path
+  * @param  out    The output of the current instance
+  * @retval None
+  */
+void LUKPIterator::checkWitness(uint16_t length, OutputData* out) const{
+	if(options.minLength == 0 || length < options.minLength){
+		return;
+	}
+	out->witnessCount++;
+	if(!options.countWitnesses && anytime != nullptr){
+		anytime->stopEarly();
+	}
+}
+
+/**
+  * @brief  Publishes a new longest path length to all parallel instances, so they can prune with it immediately.
+  *         The shared length is only increased.
+  * @param  length The length of the path that was found
+  * @retval None
+  */
+void LUKPIterator::publishLength(uint16_t length) const{
+  uint16_t seen = bestLength;
+  while(length > seen){
+    uint16_t previous = bestLength.compare_and_swap(length, seen);
+    if(previous == seen) break;
+    seen = previous;
+  }
+}
+
+//Explicit instantiations of the specialised kernels
+#define INSTANTIATE_SPECIALISED(W, H) \
+  template void LUKPIterator::startBacktracking<FixedChessboard<W, H>>(FixedChessboard<W, H>&, uint16_t, uint8_t, OutputData*) const;
+FIXED_CHESSBOARD_SIZES(INSTANTIATE_SPECIALISED)
+#undef INSTANTIATE_SPECIALISED
@@ -3,21 +3,77 @@
 
 #include "stdint.h"
 #include <vector>
+#include <chrono>
+#include <atomic>
 
 #include "tbb/blocked_range.h"
+#include "tbb/atomic.h"
+#include "tbb/parallel_do.h"
+#include "tbb/combinable.h"
 
 #include "LongestUncrossedKnightsPath.h"
+#include "Bitboard.h"
+#include "FixedChessboard.h"
+#include "SearchOptions.h"
+#include "ProgressReporter.h"
+#include "AnytimeSearch.h"
 
 class LUKPIterator {
 
 	std::vector<ThreadInputData>& input;
 	std::vector<OutputData>& output;
+	const SearchOptions& options;
+
+	//The longest path length of all parallel instances, used as bound for the pruning
+	tbb::atomic<uint16_t>& bestLength;
+
+	//Only set with the dynamic splitting: the results per thread, the number of start configurations that wait in the pool
+	//and the feeder of the worker that gives its subtrees back to the pool
+	tbb::combinable<OutputData>* results = nullptr;
+	tbb::atomic<uint32_t>* pending = nullptr;
+	uint32_t threads = 0;
+	tbb::parallel_do_feeder<ThreadInputData>* feeder = nullptr;
+
+	//Only set with the ordered dispatch: the index of the next start configuration to take
+	tbb::atomic<uint32_t>* cursor = nullptr;
+
+	//Only set with the checkpoints: the flags of the finished start configurations
+	std::vector<std::atomic<bool>>* finished = nullptr;
+
+	//Only set with the progress: the reporter that gets the finished start configurations
+	ProgressReporter* progress = nullptr;
+
+	//Only set with a deadline or a minimum length: the backtracking returns as soon as it is expired or a witness is found
+	AnytimeSearch* anytime = nullptr;
+
+	void startTimed(int) const;
 
 public:
-	LUKPIterator(std::vector<ThreadInputData>&, std::vector<OutputData>&);
+	LUKPIterator(std::vector<ThreadInputData>&, std::vector<OutputData>&, const SearchOptions&, tbb::atomic<uint16_t>&);
 	void operator()(const tbb::blocked_range<int>& r) const;
+	void operator()(ThreadInputData&, tbb::parallel_do_feeder<ThreadInputData>&) const;
+
+	void enableSplitting(tbb::combinable<OutputData>*, tbb::atomic<uint32_t>*, uint32_t);
+	void enableOrderedDispatch(tbb::atomic<uint32_t>*);
+	void enableCheckpoints(std::vector<std::atomic<bool>>*);
+	void enableProgress(ProgressReporter*);
+	void enableDeadline(AnytimeSearch*);
+	void start(ThreadInputData&, OutputData*) const;
+	bool startSpecialised(ThreadInputData&, OutputData*) const;
 
-	void backtracking(Chessboard&, std::pair<uint8_t, uint8_t>, uint8_t, OutputData*) const;
+	template<typename Board> void startBacktracking(Board&, uint16_t, uint8_t, OutputData*) const;
+	template<typename Board> void backtracking(Board&, uint16_t, uint8_t, OutputData*) const;
+	template<typename Board> void backtrackingInPlace(Board&, uint16_t, uint8_t, OutputData*) const;
+	template<typename Board> bool isSplittable(Board&) const;
+	template<typename Board> void split(Board&, uint16_t, uint8_t) const;
+	uint16_t getBoundLimit() const;
+	template<typename Board> bool isPrunable(Board&, uint16_t) const;
+	template<typename Board> bool isDisconnected(Board&, uint16_t, OutputData*) const;
+	template<typename Board> bool isCanonicalClosing(Board&, uint8_t) const;
+	void publishLength(uint16_t) const;
+	void offerPath(const OutputData*) const;
+	void checkWitness(uint16_t, OutputData*) const;
+	bool isExpired() const;
 };
 
 #endif /* LUKPITERATION_H */
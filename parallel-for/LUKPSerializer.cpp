@@ -0,0 +1,121 @@
+#include "LUKPSerializer.h"
+
+/**
+  * @brief  Writes a chessboard: the size, the root and the moves of all fields of the board.
+  * @param  stream The stream to write to
+  * @param  cboard The chessboard to write
+  * @retval None
+  */
+void LUKPSerializer::writeBoard(std::ostream& stream, const Chessboard& cboard) {
+  std::pair<uint8_t, uint8_t> root = cboard.getRoot();
+  stream << (int) cboard.getWidth() << " " << (int) cboard.getHeight() << " " << (int) root.first << " " << (int) root.second;
+  for(uint8_t y = 0; y < cboard.getHeight(); y++) {
+    for(uint8_t x = 0; x < cboard.getWidth(); x++) {
+      stream << " " << (int) cboard.at(x + BORDER_OFFSET, y + BORDER_OFFSET);
+    }
+  }
+}
+
+/**
+  * @brief  Reads a chessboard that was written by writeBoard(). The path length is restored by setting the fields again.
+  * @param  stream The stream to read from
+  * @retval The chessboard
+  */
+Chessboard LUKPSerializer::readBoard(std::istream& stream) {
+  int width = 0, height = 0, rootX = 0, rootY = 0;
+  stream >> width >> height >> rootX >> rootY;
+  if(width == 0 || height == 0) {
+    return Chessboard();
+  }
+
+  Chessboard cboard(width, height);
+  std::pair<uint8_t, uint8_t> root = std::make_pair((uint8_t) rootX, (uint8_t) rootY);
+  for(uint8_t y = 0; y < height; y++) {
+    for(uint8_t x = 0; x < width; x++) {
+      int moves = 0;
+      stream >> moves;
+      std::pair<uint8_t, uint8_t> field = std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET);
+      if(moves == 0b00000000) continue;
+
+      //Blocked fields of the canonical mode aren't part of the path
+      if(moves == 0b11111111) {
+        cboard.updateField(moves, field);
+      }else if(field == root) {
+        cboard.setRoot(moves, field);
+      }else{
+        cboard.setField(moves, field);
+      }
+    }
+  }
+  return cboard;
+}
+
+/**
+  * @brief  Writes a start configuration: the source, the incoming move, the estimate and the board.
+  * @param  stream The stream to write to
+  * @param  data   The start configuration
+  * @retval None
+  */
+void LUKPSerializer::writeInput(std::ostream& stream, const ThreadInputData& data) {
+  stream << data.source << " " << (int) data.incomming_move << " " << data.estimate << " ";
+  writeBoard(stream, data.cboard);
+}
+
+/**
+  * @brief  Reads a start configuration that was written by writeInput().
+  * @param  stream The stream to read from
+  * @retval The start configuration
+  */
+ThreadInputData LUKPSerializer::readInput(std::istream& stream) {
+  ThreadInputData data;
+  int move = 0;
+  stream >> data.source >> move >> data.estimate;
+  data.incomming_move = move;
+  data.cboard = readBoard(stream);
+  return data;
+}
+
+/**
+  * @brief  Writes a result: the longest path length and count, the pruning counters, the time and the board of the longest path.
+  * @param  stream The stream to write to
+  * @param  out    The result
+  * @retval None
+  */
+void LUKPSerializer::writeOutput(std::ostream& stream, const OutputData& out) {
+  stream << out.longestPathLength << " " << out.longestPathCount << " " << out.reachabilityStats.checked << " " << out.reachabilityStats.pruned << " " << out.seconds << " " << out.nodes << " ";
+  writeBoard(stream, out.longestPathBoard);
+}
+
+/**
+  * @brief  Reads a result that was written by writeOutput().
+  * @param  stream The stream to read from
+  * @retval The result
+  */
+OutputData LUKPSerializer::readOutput(std::istream& stream) {
+  OutputData out;
+  stream >> out.longestPathLength >> out.longestPathCount >> out.reachabilityStats.checked >> out.reachabilityStats.pruned >> out.seconds >> out.nodes;
+  out.longestPathBoard = readBoard(stream);
+  return out;
+}
+
+/**
+  * @brief  Writes the options that change the backtracking of a start configuration.
+  * @param  stream  The stream to write to
+  * @param  options The search options
+  * @retval None
+  */
+void LUKPSerializer::writeOptions(std::ostream& stream, const SearchOptions& options) {
+  stream << options.inPlace << " " << options.bitboard << " " << options.specialised << " " << options.bound << " " << options.countPaths << " " << (int) options.reachability << " " << options.canonical;
+}
+
+/**
+  * @brief  Reads the options that were written by writeOptions(). The other options are left unchanged.
+  * @param  stream  The stream to read from
+  * @param  options The search options to update
+  * @retval None
+  */
+void LUKPSerializer::readOptions(std::istream& stream, SearchOptions& options) {
+  int reachability = 0;
+  stream >> options.inPlace >> options.bitboard >> options.specialised >> options.bound >> options.countPaths >> reachability >> options.canonical;
+  options.reachability = reachability;
+}
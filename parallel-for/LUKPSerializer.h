@@ -0,0 +1,30 @@
+#ifndef LUKPSERIALIZER_H
+#define LUKPSERIALIZER_H
+
+#include "stdint.h"
+#include <iostream>
+
+#include "Chessboard.h"
+#include "LUKPData.h"
+#include "SearchOptions.h"
+
+/**
+ * Converts the start configurations, the results and the search options to text and back.
+ * Each object is written as space separated values without a line break, so it can be embedded in a line of a file or a message.
+ */
+class LUKPSerializer {
+public:
+	static void writeBoard(std::ostream&, const Chessboard&);
+	static Chessboard readBoard(std::istream&);
+
+	static void writeInput(std::ostream&, const ThreadInputData&);
+	static ThreadInputData readInput(std::istream&);
+
+	static void writeOutput(std::ostream&, const OutputData&);
+	static OutputData readOutput(std::istream&);
+
+	static void writeOptions(std::ostream&, const SearchOptions&);
+	static void readOptions(std::istream&, SearchOptions&);
+};
+
+#endif /* LUKPSERIALIZER_H */
@@ -8,6 +8,16 @@
   */
 std::vector<std::pair<uint8_t, uint8_t>> LUKPStartOptimization::getStartingFields(Chessboard& cboard) const{
   std::vector<std::pair<uint8_t, uint8_t>> fields;
+  //In the canonical mode every field is a start field, the cycles are separated by getStartingBoard() instead
+  if(this->options.canonical){
+    for(uint8_t y = 0; y < cboard.getHeight(); ++y){
+      for(uint8_t x = 0; x < cboard.getWidth(); ++x){
+        fields.push_back(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+      }
+    }
+    return fields;
+  }
+
   for(uint8_t x = 0; x <= (cboard.getWidth()  - 1)/2; ++x){
 	  for(uint8_t y = 0; y<= (cboard.getHeight() - 1)/2; ++y){
       // Just take the lower left quadrant, the others can be rotated or mirrored on the horizontal and vertical axis.
@@ -21,6 +31,30 @@ std::vector<std::pair<uint8_t, uint8_t>> LUKPStartOptimization::getStartingField
   return fields;
 }
 
+/**
+  * @brief  Sets the options that select how the start configurations are calculated.
+  * @param  _options The search options
+  * @retval None
+  */
+void LUKPStartOptimization::setSearchOptions(const SearchOptions& _options){
+  this->options = _options;
+}
+
+/**
+  * @brief  Returns a copy of the chessboard to start from the given root. In the canonical mode all fields before the root
+  *         are blocked, so a cycle is only found from its field with the smallest index.
+  * @param  cboard  The empty chessboard
+  * @param  root    The root (start field)
+  * @retval The chessboard to start from
+  */
+Chessboard LUKPStartOptimization::getStartingBoard(Chessboard& cboard, std::pair<uint8_t, uint8_t> root) const{
+  Chessboard start = cboard;
+  if(this->options.canonical){
+    start.blockFieldsBefore(start.toIndex(root));
+  }
+  return start;
+}
+
 /**
   * @brief  Start move optimization: Determins all moves for a given start field that need to be selected as starting moves for the algorithm.
   * This takes symmetries into concideration. For details see chapter 2.1 figure 6.
@@ -39,10 +73,12 @@ uint8_t LUKPStartOptimization::getStartingMoves(Chessboard& cboard, std::pair<ui
     if(cboard.at(target.first, target.second) != 0b11111111) { moves |= move;}
   }
 
-  //Optimize symmetric moves (diagonal, vertical, horizontal)
-  if(width == height && root.first == root.second)	  { moves &= 0b00011110; }  //Diagonal axis
-  if((width % 2 == 1) && (root.first == (width/2)))	  { moves &= 0b00001111; }  //Vertical axis 
-  if((height % 2 == 1) && (root.second == (height/2))){ moves &= 0b00111100; }  //Horizontal axis
+  //Optimize symmetric moves (diagonal, vertical, horizontal). In the canonical mode every field is a root, so there are no symmetries.
+  if(!this->options.canonical){
+    if(width == height && root.first == root.second)	  { moves &= 0b00011110; }  //Diagonal axis
+    if((width % 2 == 1) && (root.first == (width/2)))	  { moves &= 0b00001111; }  //Vertical axis 
+    if((height % 2 == 1) && (root.second == (height/2))){ moves &= 0b00111100; }  //Horizontal axis
+  }
 
   for(uint8_t move = 0b00000001; move > 0; move <<= 1) { if((move & moves) != 0) { count++; } }
   if(count < 2) { return moves; }
@@ -63,14 +99,14 @@ uint8_t LUKPStartOptimization::getStartingMoves(Chessboard& cboard, std::pair<ui
   *         Due to the fact that this can end the path, the stats (length, count, path) of the finished board need to be stored aswell. 
   *         This method gets used to calculate enough start configurations for the available threads to use as starting nodes/tasks.
   * @param  cboard        The current copy of the chessboard
-  * @param  source        The current field
+  * @param  source        The field index of the current field
   * @param  incoming_move The current move that leads to the source
   * @retval A list of the valid next move configurations (field, move, and the current chessboard state)
   */
-std::vector<ThreadInputData> LUKPStartOptimization::getNextMoves(Chessboard& cboard, std::pair<uint8_t, uint8_t> source, uint8_t incoming_move){
+std::vector<ThreadInputData> LUKPStartOptimization::getNextMoves(Chessboard& cboard, uint16_t source, uint8_t incoming_move){
   std::vector<ThreadInputData> next;
   for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
-    std::pair<uint8_t, uint8_t> target = cboard.doMove(source, outgoing_move);
+    uint16_t target = cboard.doMove(source, outgoing_move);
 
     if(!cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(source, outgoing_move)) {
       //The next move is valid, so it gets stored in a new board copy
@@ -84,13 +120,13 @@ std::vector<ThreadInputData> LUKPStartOptimization::getNextMoves(Chessboard& cbo
       in.source = target;
       in.incomming_move = outgoing_move;
       next.push_back(in);
-    } else if(cboard.isFinishable(source, target, outgoing_move)) {
+    } else if(cboard.isFinishable(source, target, outgoing_move) && this->isCanonicalClosing(cboard, outgoing_move)) {
       //The board can be finised. The finishing move gets stored in a new board copy.
       uint8_t moves = outgoing_move | cboard.rotate180(incoming_move);
       Chessboard cpy = cboard;
-      std::pair<uint8_t, uint8_t> root = cpy.getRoot();
+      uint16_t root = cpy.getRootIndex();
       cpy.setField(moves, source);
-      cpy.updateField((cpy.at(root.first, root.second) | cboard.rotate180(outgoing_move)), root);
+      cpy.updateField((cpy.at(root) | cboard.rotate180(outgoing_move)), root);
 
       //Check if the completed path is of an important length
       if(cpy.getLength() == longestPathLength){
@@ -100,12 +136,27 @@ std::vector<ThreadInputData> LUKPStartOptimization::getNextMoves(Chessboard& cbo
         this->longestPathCount = 1;
         this->longestPathBoard = cpy;
       }
+      if(this->options.minLength > 0 && cpy.getLength() >= this->options.minLength){
+        this->witnessCount++;
+      }
     }
     //else { Field is used or crosses path -> do nothing}
   }
   return next;
 }
 
+/**
+  * @brief  In the canonical mode each cycle is only accepted in one direction: the move that closes the cycle
+  *         needs to be a larger move of the root than the first move. Otherwise every closing move is accepted.
+  * @param  cboard        The current chessboard
+  * @param  outgoing_move The move that closes the cycle
+  * @retval true:   The cycle is accepted
+  *         false:  The cycle is found in the other direction
+  */
+bool LUKPStartOptimization::isCanonicalClosing(Chessboard& cboard, uint8_t outgoing_move) const{
+  return !this->options.canonical || cboard.rotate180(outgoing_move) > cboard.at(cboard.getRootIndex());
+}
+
 /**
   * @brief  This function calculates start configurations (field + move) for the algorithm. 
   * For this, the start fields with their valid start moves are calculated first. 
@@ -129,17 +180,18 @@ std::queue<ThreadInputData> LUKPStartOptimization::getStartingCombinations(Chess
   std::vector<std::pair<uint8_t, uint8_t>> fields = this->getStartingFields(cboard);
   //For each of them, get their valid start moves and store them as start configration.
 	for(int i=0; i<fields.size(); i++){
-		uint8_t moves = this->getStartingMoves(cboard, fields[i]);
+		Chessboard start = this->getStartingBoard(cboard, fields[i]);
+		uint8_t moves = this->getStartingMoves(start, fields[i]);
 		for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
 			if((moves & move) == 0) continue;
 
       ThreadInputData data;
       std::pair<uint8_t, uint8_t> root = fields[i];
 
-      Chessboard cpy = cboard;
+      Chessboard cpy = start;
       //Store the start configuration
       cpy.setRoot(move, root);
-      data.cboard = cpy; data.source = cpy.doMove(root, move); data.incomming_move = move;
+      data.cboard = cpy; data.source = cpy.doMove(cpy.getRootIndex(), move); data.incomming_move = move;
       startingCombinations.push(data);
 	  }
   }
@@ -171,3 +223,111 @@ std::queue<ThreadInputData> LUKPStartOptimization::getStartingCombinations(Chess
 
   return startingCombinations;
 }
+
+/**
+  * @brief  Estimates the number of nodes of a subtree with Knuth's estimator. Each probe follows a random path from the
+  *         start configuration to a leaf. The product of the branching factors along the path estimates the number of nodes
+  *         on each level, their sum the size of the subtree. The estimate is the average of all probes.
+  * @param  data  The start configuration of the subtree
+  * @param  rng   The random generator for the moves of the probes
+  * @retval The estimated number of nodes
+  */
+double LUKPStartOptimization::estimateSubtree(const ThreadInputData& data, std::mt19937& rng) const{
+  double sum = 0;
+  for(uint16_t probe = 0; probe < this->options.estimateProbes; probe++){
+    Chessboard cboard = data.cboard;
+    uint16_t source = data.source;
+    uint8_t incoming_move = data.incomming_move;
+    double level = 1, nodes = 1;
+
+    while(true){
+      //Collect the moves that continue the path
+      uint8_t moves[MOVE_COUNT];
+      uint8_t count = 0;
+      for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
+        uint16_t target = cboard.doMove(source, outgoing_move);
+        if(!cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(source, outgoing_move)) {
+          moves[count++] = outgoing_move;
+        }
+      }
+      if(count == 0) break;
+
+      level *= count;
+      nodes += level;
+
+      uint8_t move = moves[rng() % count];
+      cboard.setField(move | cboard.rotate180(incoming_move), source);
+      source = cboard.doMove(source, move);
+      incoming_move = move;
+    }
+    sum += nodes;
+  }
+  return sum / this->options.estimateProbes;
+}
+
+/**
+  * @brief  Balances the start configurations by their estimated size. The largest start configuration is replaced by its
+  *         next moves, as long as it is larger than its share of the total estimate. This stops at 2 * max_tasks configurations.
+  *         Afterwards the start configurations are sorted largest first, so the large subtrees don't start last.
+  *         Paths that are finished while splitting are stored like in getStartingCombinations().
+  * @param  input             The start configurations, they are replaced by the balanced ones
+  * @param  hardware_threads  The number of hardware threads
+  * @param  max_tasks         The maxium number of start configurations calculated by getStartingCombinations()
+  * @retval None
+  */
+void LUKPStartOptimization::balanceStartingCombinations(std::vector<ThreadInputData>& input, uint16_t hardware_threads, uint32_t max_tasks){
+  //A fixed seed, so the same board is always split the same way
+  std::mt19937 rng(1);
+  auto smaller = [](const ThreadInputData& a, const ThreadInputData& b) { return a.estimate < b.estimate; };
+
+  double total = 0;
+  for(ThreadInputData& data : input){
+    data.estimate = this->estimateSubtree(data, rng);
+    total += data.estimate;
+  }
+
+  //Split the largest start configuration, the vector is kept as heap with the largest on top
+  std::make_heap(input.begin(), input.end(), smaller);
+  double share = total / ((double) hardware_threads * ESTIMATE_BALANCE);
+  while(!input.empty() && input.front().estimate > share && input.size() < 2 * max_tasks){
+    std::pop_heap(input.begin(), input.end(), smaller);
+    ThreadInputData largest = input.back();
+    input.pop_back();
+
+    std::vector<ThreadInputData> next = this->getNextMoves(largest.cboard, largest.source, largest.incomming_move);
+    for(ThreadInputData& data : next){
+      data.estimate = this->estimateSubtree(data, rng);
+      input.push_back(data);
+      std::push_heap(input.begin(), input.end(), smaller);
+    }
+  }
+
+  std::sort_heap(input.begin(), input.end(), smaller);
+  std::reverse(input.begin(), input.end());
+}
+
+/**
+  * @brief  Selects the start configurations of a shard. With the estimation the start configurations are sorted largest first
+  *         and each one is given to the shard with the smallest estimated cost so far. Otherwise every count-th start
+  *         configuration belongs to the shard. The selection only depends on the list, so every shard selects disjoint parts of the same list.
+  * @param  input  All start configurations
+  * @param  index  The index of the shard
+  * @param  count  The number of shards
+  * @retval The start configurations of the shard
+  */
+std::vector<ThreadInputData> LUKPStartOptimization::selectShard(const std::vector<ThreadInputData>& input, uint16_t index, uint16_t count) const{
+  std::vector<ThreadInputData> shard;
+  if(this->options.estimateProbes > 0){
+    std::vector<double> cost(count, 0);
+    for(const ThreadInputData& data : input){
+      uint16_t cheapest = std::min_element(cost.begin(), cost.end()) - cost.begin();
+      cost[cheapest] += data.estimate;
+      if(cheapest == index) shard.push_back(data);
+    }
+  }else{
+    for(size_t i = index; i < input.size(); i += count){
+      shard.push_back(input[i]);
+    }
+  }
+  return shard;
+}
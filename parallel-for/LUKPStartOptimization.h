@@ -4,23 +4,40 @@
 #include "stdint.h"
 #include <vector>
 #include <queue>
+#include <random>
+#include <algorithm>
 
 #include "Chessboard.h"
+#include "SearchOptions.h"
 #include "LUKPData.h"
 
+//A start configuration is split further while its estimate is larger than the total estimate divided by threads * ESTIMATE_BALANCE
+#define ESTIMATE_BALANCE 8
+
 class LUKPStartOptimization {
 
 private:
+	SearchOptions options;
+
 	std::vector<std::pair<uint8_t, uint8_t>> getStartingFields(Chessboard&) const;
     uint8_t getStartingMoves(Chessboard&, std::pair<uint8_t, uint8_t>) const;
-	std::vector<ThreadInputData> getNextMoves(Chessboard&, std::pair<uint8_t, uint8_t>, uint8_t);
+	std::vector<ThreadInputData> getNextMoves(Chessboard&, uint16_t, uint8_t);
+	Chessboard getStartingBoard(Chessboard&, std::pair<uint8_t, uint8_t>) const;
+	bool isCanonicalClosing(Chessboard&, uint8_t) const;
+	double estimateSubtree(const ThreadInputData&, std::mt19937&) const;
 
 public:
     uint16_t longestPathLength = 0;
     uint16_t longestPathCount = 0;
     Chessboard longestPathBoard;
 
+    //The number of paths with at least the minimum length that end in the start optimization
+    uint64_t witnessCount = 0;
+
+    void setSearchOptions(const SearchOptions&);
     std::queue<ThreadInputData> getStartingCombinations(Chessboard&, uint16_t, uint32_t, uint32_t);
+    void balanceStartingCombinations(std::vector<ThreadInputData>&, uint16_t, uint32_t);
+    std::vector<ThreadInputData> selectShard(const std::vector<ThreadInputData>&, uint16_t, uint16_t) const;
 };
 
 #endif /* LUKPSTARTOPTIMIZATION_H */
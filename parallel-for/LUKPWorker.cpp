@@ -0,0 +1,92 @@
+#include "LUKPWorker.h"
+
+/**
+  * @brief  Constructor of a worker.
+  * @param  _host     The name or address of the coordinator
+  * @param  _port     The port of the coordinator
+  * @param  _threads  The number of connections that process start configurations in parallel
+  */
+LUKPWorker::LUKPWorker(const std::string& _host, uint16_t _port, uint16_t _threads) : host(_host), port(_port), threads(_threads) {
+  this->bestLength = 0;
+  this->finishedCount = 0;
+}
+
+/**
+  * @brief  Runs the worker until the coordinator is done or the connections are lost.
+  * @retval None
+  */
+void LUKPWorker::run() {
+  std::vector<std::thread> connections;
+  for(uint16_t i = 0; i < this->threads; i++) {
+    connections.push_back(std::thread(&LUKPWorker::work, this));
+  }
+  for(std::thread& connection : connections) {
+    connection.join();
+  }
+  std::cout << "Worker finished " << this->finishedCount << " start configurations." << std::endl;
+}
+
+/**
+  * @brief  Processes the start configurations of one connection to the coordinator.
+  * @retval None
+  */
+void LUKPWorker::work() {
+  int socket = -1;
+  for(int attempt = 0; attempt < WORKER_CONNECT_ATTEMPTS && socket < 0; attempt++) {
+    socket = LUKPConnection::connectTo(this->host, this->port);
+    if(socket < 0) std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+  if(socket < 0) {
+    std::cerr << "Can't connect to " << this->host << ":" << this->port << "." << std::endl;
+    return;
+  }
+
+  LUKPConnection connection(socket);
+  SearchOptions options;
+  std::string line;
+  if(!connection.sendLine("HELLO")) return;
+
+  while(connection.readLine(line)) {
+    std::istringstream message(line);
+    std::string type;
+    message >> type;
+
+    if(type == "OPTIONS") {
+      LUKPSerializer::readOptions(message, options);
+    }else if(type == "UNIT") {
+      uint32_t index = 0;
+      uint16_t length = 0;
+      message >> index >> length;
+      this->raiseLength(length);
+
+      std::vector<ThreadInputData> input;
+      std::vector<OutputData> output(1);
+      input.push_back(LUKPSerializer::readInput(message));
+
+      LUKPIterator iterator(input, output, options, this->bestLength);
+      iterator(tbb::blocked_range<int>(0, 1, 1));
+      this->finishedCount++;
+
+      std::ostringstream result;
+      result << "RESULT " << index << " ";
+      LUKPSerializer::writeOutput(result, output[0]);
+      if(!connection.sendLine(result.str())) return;
+    }else if(type == "DONE") {
+      return;
+    }
+  }
+}
+
+/**
+  * @brief  Raises the bound of the pruning to the longest path length of the coordinator. The bound is only increased.
+  * @param  length The longest path length of the coordinator
+  * @retval None
+  */
+void LUKPWorker::raiseLength(uint16_t length) {
+  uint16_t seen = this->bestLength;
+  while(length > seen) {
+    uint16_t previous = this->bestLength.compare_and_swap(length, seen);
+    if(previous == seen) break;
+    seen = previous;
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef LUKPWORKER_H
+#define LUKPWORKER_H
+
+#include "stdint.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "tbb/atomic.h"
+#include "tbb/blocked_range.h"
+
+#include "LUKPData.h"
+#include "LUKPConnection.h"
+#include "LUKPSerializer.h"
+#include "LUKPIterator.h"
+#include "SearchOptions.h"
+
+//A worker retries to connect to the coordinator once per second, so it can be started before the coordinator
+#define WORKER_CONNECT_ATTEMPTS 30
+
+/**
+ * A worker process of the distributed mode. It opens one connection to the coordinator per thread. Each connection
+ * receives one start configuration at a time, backtracks it and sends the result back, until the coordinator is done.
+ * @see LUKPCoordinator
+ */
+class LUKPWorker {
+
+private:
+	std::string host;
+	uint16_t port;
+	uint16_t threads;
+
+	//The longest path length of all threads of this worker and of the coordinator, used as bound for the pruning
+	tbb::atomic<uint16_t> bestLength;
+	tbb::atomic<uint32_t> finishedCount;
+
+	void work();
+	void raiseLength(uint16_t);
+
+public:
+	LUKPWorker(const std::string&, uint16_t, uint16_t);
+
+	void run();
+};
+
+#endif /* LUKPWORKER_H */
@@ -17,6 +17,88 @@ void LongestUncrossedKnightsPath::setThreadLimit(uint16_t threads){
 	this->n_thread_limit = threads;
 }
 
+/**
+  * @brief  Sets the options that select how the backtracking is executed.
+  * @param  _options The search options
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::setSearchOptions(const SearchOptions& _options){
+	this->options = _options;
+	this->startOptimization.setSearchOptions(_options);
+}
+
+/**
+  * @brief  Sets a longest length that is known before the search. It is used as bound for the pruning (-p) from the start.
+  * @param  length The known longest length, 0 if it isn't known
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::setKnownLength(uint16_t length){
+	this->knownLength = std::max(length, this->incumbent.longestPathLength);
+}
+
+/**
+  * @brief  Embeds the path of a smaller board (or of the same size) and keeps it as incumbent if it is longer than
+  *         the one before. Its length is a known length for the pruning.
+  * @param  path The board with the closed path
+  * @retval true:   The path was embedded and is the new incumbent
+  *         false:  The path doesn't fit or isn't longer than the incumbent
+  */
+bool LongestUncrossedKnightsPath::setIncumbent(const Chessboard& path){
+	Chessboard cboard(this->chessboard.getWidth(), this->chessboard.getHeight());
+	if(path.getLength() <= this->incumbent.longestPathLength || !LUKPEmbedding::embed(path, cboard)){
+		return false;
+	}
+	this->incumbent.longestPathLength = cboard.getLength();
+	this->incumbent.longestPathCount = 1;
+	this->incumbent.longestPathBoard = cboard;
+	this->knownLength = std::max(this->knownLength, this->incumbent.longestPathLength);
+	return true;
+}
+
+/**
+  * @brief  Adds the incumbent to the results that are known before the backtracking. Only without counting the paths,
+  *         so the search only needs to find longer paths. The counted paths of its length are found by the search itself.
+  * @param  base The results that are known before the backtracking
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::addIncumbent(OutputData& base) const{
+	if(!this->options.countPaths && this->incumbent.longestPathLength > 0){
+		base += this->incumbent;
+	}
+}
+
+/**
+  * @brief  Returns the first bound for the pruning. Without counting the paths, a path of the known length still needs
+  *         to be found once, so the known length can only be used as bound if the paths are counted.
+  * @param  base The results that are known before the backtracking
+  * @retval The bound
+  */
+uint16_t LongestUncrossedKnightsPath::getInitialBound(const OutputData& base) const{
+	uint16_t known = this->options.countPaths || this->knownLength == 0 ? this->knownLength : this->knownLength - 1;
+	return std::max(base.longestPathLength, known);
+}
+
+/**
+  * @brief  Returns the final result of the last search.
+  * @retval The result
+  */
+OutputData LongestUncrossedKnightsPath::getResult() const{
+	OutputData result;
+	result.longestPathLength = this->longestPathLength;
+	result.longestPathCount = this->longestPathCount;
+	result.longestPathBoard = this->longestPathBoard;
+	return result;
+}
+
+/**
+  * @brief  Checks whether the last search was complete.
+  * @retval true:   All start configurations were searched
+  *         false:  The deadline stopped the search
+  */
+bool LongestUncrossedKnightsPath::isComplete() const{
+	return this->complete;
+}
+
 /**
   * @brief  Starts the algorithm with a parallel_for implementation
   * @retval None
@@ -28,54 +110,254 @@ void LongestUncrossedKnightsPath::run() {
 		hardware_threads = this->n_thread_limit;
 	}
 
+	//The results that are known before the backtracking: the finished paths of the start optimization or of the checkpoint
+	std::vector<ThreadInputData> input;
+	OutputData base;
+	double previousSeconds = 0;
+	std::string shard = this->options.shardCount > 0 ? "_shard_" + std::to_string(this->options.shardIndex) + "_of_" + std::to_string(this->options.shardCount) : "";
+	Checkpoint checkpoint(this->chessboard, shard);
+
+	//The shards need the same start configurations on every machine, so they use the number of shards instead of the threads
+	uint32_t frontier_threads = this->options.shardCount > 0 ? this->options.shardCount : hardware_threads;
+
+	if(this->options.resume && checkpoint.load(input, base, previousSeconds)){
+		std::cout << "Resuming " << input.size() << " pending start configurations after " << previousSeconds << " seconds." << std::endl;
+	}else{
+		input = this->createStartConfigurations(frontier_threads, base);
+
+		//The paths of the start optimization are only counted by the first shard
+		if(this->options.shardCount > 0){
+			input = this->startOptimization.selectShard(input, this->options.shardIndex, this->options.shardCount);
+			if(this->options.shardIndex != 0) base = OutputData();
+			std::cout << "Searching shard " << this->options.shardIndex << " of " << this->options.shardCount << " with " << input.size() << " start configurations." << std::endl;
+		}
+	}
+
+	//Without counting the witnesses, a witness of the start optimization already answers the question
+	if(this->options.minLength > 0 && !this->options.countWitnesses && base.witnessCount > 0){
+		input.clear();
+	}
+
+	//For each configuraton an output object gets created.
+	std::vector<OutputData> output(input.size());
+	std::vector<std::atomic<bool>> finished(input.size());
+	AnytimeSearch anytime;
+	auto begin = std::chrono::steady_clock::now();
+
+	//Run the parallel_for loop
+	if(!input.empty()){
+		tbb::task_scheduler_init init(n_thread_limit > 0 ? n_thread_limit : tbb::task_scheduler_init::automatic);
+		//The known paths are the first bound for the pruning
+		tbb::atomic<uint16_t> bestLength;
+		bestLength = this->getInitialBound(base);
+
+		LUKPIterator iterator(input, output, this->options, bestLength);
+
+		//The checkpoints need an output per start configuration, so they aren't written with the dynamic splitting.
+		//The coordinator marks the start configurations as finished when their result is received.
+		if(this->options.checkpointInterval > 0 && (this->options.splitDepth == 0 || this->options.coordinatorPort > 0)){
+			iterator.enableCheckpoints(&finished);
+			checkpoint.start(this->options.checkpointInterval, input, finished, output, base, previousSeconds);
+		}
+
+		//The first witness stops the search like the deadline
+		if(this->options.deadline > 0 || this->options.minLength > 0){
+			if(this->options.deadline > 0){
+				anytime.start(this->options.deadline);
+				anytime.offerPath(base.longestPathBoard);
+			}
+			anytime.addUnits(input.size());
+			iterator.enableDeadline(&anytime);
+		}
+
+		ProgressReporter progress;
+		if(this->options.progressInterval > 0){
+			double estimate = 0;
+			for(const ThreadInputData& data : input){
+				estimate += data.estimate;
+			}
+			progress.mergeLongest(base.longestPathLength, base.longestPathCount);
+			progress.start(this->options.progressInterval, input.size(), estimate);
+			iterator.enableProgress(&progress);
+		}
+
+		if(this->options.coordinatorPort > 0){
+			//The start configurations are processed by the worker processes
+			LUKPCoordinator coordinator(this->options.coordinatorPort, this->options);
+			if(this->options.progressInterval > 0){
+				coordinator.enableProgress(&progress);
+			}
+			if(this->options.deadline > 0){
+				coordinator.enableDeadline(&anytime);
+			}
+			coordinator.run(input, output, finished, bestLength);
+		}else if(this->options.splitDepth > 0){
+			//The start configurations are a pool that the workers fill up with parts of their subtrees when it runs low.
+			//The results are stored per thread and replace the outputs of the start configurations.
+			tbb::combinable<OutputData> results;
+			tbb::atomic<uint32_t> pending;
+			pending = input.size();
+			iterator.enableSplitting(&results, &pending, hardware_threads);
+			tbb::parallel_do(input.begin(), input.end(), iterator);
+
+			output.clear();
+			results.combine_each([&output](const OutputData& out) { output.push_back(out); });
+		}else if(this->options.estimateProbes > 0){
+			//Each worker takes the next largest start configuration
+			tbb::atomic<uint32_t> cursor;
+			cursor = 0;
+			iterator.enableOrderedDispatch(&cursor);
+			tbb::simple_partitioner sp;
+			tbb::parallel_for(tbb::blocked_range<int>(0, hardware_threads, 1), iterator, sp);
+
+			FileExporter fileExporter;
+			fileExporter.exportEstimates(this->chessboard, input, output);
+		}else{
+			tbb::simple_partitioner sp;
+			//Run through each start configuration.
+			tbb::parallel_for(tbb::blocked_range<int>(0, input.size(), 1), iterator, sp);
+		}
+		checkpoint.stop();
+		progress.stop();
+		anytime.stop();
+	}
+	this->complete = !anytime.isExpired();
+
+	if(!this->complete){
+		//The pending start configurations stay in the checkpoint, so the search can be resumed
+		if(this->options.checkpointInterval > 0 && (this->options.splitDepth == 0 || this->options.coordinatorPort > 0)){
+			std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - begin;
+			checkpoint.save(input, finished, output, base, previousSeconds + elapsed_seconds.count());
+			std::cout << "The checkpoint keeps the pending start configurations, the search continues with --resume." << std::endl;
+		}
+	}else if(this->options.checkpointInterval > 0 || this->options.resume){
+		//The search is complete, so the checkpoint isn't needed anymore
+		checkpoint.remove();
+	}
+	anytime.report();
+
+	OutputData result = this->collectAndExportResults(output, base);
+	if(!this->complete && this->options.shardCount > 0){
+		std::cout << "The result of the shard isn't stored, because the shard wasn't searched completely." << std::endl;
+	}else if(this->options.shardCount > 0){
+		FileExporter fileExporter;
+		fileExporter.exportShardResult(this->chessboard, this->options.shardIndex, this->options.shardCount, result);
+	}
+}
+
+/**
+  * @brief  Calculates the start configurations of the board.
+  * @param  threads The number of threads the start configurations are balanced for
+  * @param  base    Stores the paths that were already finished by the start optimization
+  * @retval The start configurations, largest first with the estimation
+  */
+std::vector<ThreadInputData> LongestUncrossedKnightsPath::createStartConfigurations(uint32_t threads, OutputData& base) {
 	//Based on the number of threads, calculate a number of start configurations to increase the number of tasks that can be run parallel.
 	//This is used to balance the load between the threads, because the sub trees of a start field can be from different depth.
-	uint32_t min_tasks = hardware_threads * chessboard.getWidth() * chessboard.getHeight() * (chessboard.getWidth() + chessboard.getHeight())/4;
-	uint32_t max_tasks = (hardware_threads + 1) * chessboard.getWidth() * chessboard.getHeight() * (chessboard.getWidth() + chessboard.getHeight())/4;
-	std::queue<ThreadInputData> startingCombinations = this->startOptimization.getStartingCombinations(this->chessboard, hardware_threads, min_tasks, max_tasks);
+	uint32_t min_tasks = threads * chessboard.getWidth() * chessboard.getHeight() * (chessboard.getWidth() + chessboard.getHeight())/4;
+	uint32_t max_tasks = (threads + 1) * chessboard.getWidth() * chessboard.getHeight() * (chessboard.getWidth() + chessboard.getHeight())/4;
+	std::queue<ThreadInputData> startingCombinations = this->startOptimization.getStartingCombinations(this->chessboard, threads, min_tasks, max_tasks);
 
-	//The start configurations get transformed into a vector and for each configuraton an output object gets created.
+	//The start configurations get transformed into a vector.
 	std::vector<ThreadInputData> input;
-	std::vector<OutputData> output;
 	while(!startingCombinations.empty())
 	{
 		input.push_back(startingCombinations.front());
-	 	OutputData out; output.push_back(out);
 		startingCombinations.pop();
 	}
 
-	//Run the parallel_for loop
-	if(!input.empty()){
-		tbb::task_scheduler_init init(n_thread_limit > 0 ? n_thread_limit : tbb::task_scheduler_init::automatic);
-		LUKPIterator iterator(input, output);
-		tbb::simple_partitioner sp;
-		//Run through each start configuration.
-		tbb::parallel_for(tbb::blocked_range<int>(0, input.size(), 1), iterator, sp);
+	//With the estimation the largest start configurations are split further and all are sorted largest first
+	if(this->options.estimateProbes > 0 && !input.empty()){
+		this->startOptimization.balanceStartingCombinations(input, threads, max_tasks);
+		std::cout << "Balanced " << input.size() << " start configurations, the largest has an estimate of " << (uint64_t) input.front().estimate << " nodes." << std::endl;
 	}
-	this->collectAndExportResults(output);
+
+	base.longestPathLength = this->startOptimization.longestPathLength;
+	base.longestPathCount = this->startOptimization.longestPathCount;
+	base.longestPathBoard = this->startOptimization.longestPathBoard;
+	base.witnessCount = this->startOptimization.witnessCount;
+	this->addIncumbent(base);
+	return input;
+}
+
+/**
+  * @brief  Merges the result files of all shards to the final result.
+  * @retval true:   The results of all shards were merged
+  *         false:  The result file of a shard is missing
+  */
+bool LongestUncrossedKnightsPath::mergeShards() {
+	FileExporter fileExporter;
+	OutputData result;
+	for(uint16_t i = 0; i < this->options.mergeShards; i++){
+		OutputData shard;
+		if(!fileExporter.importShardResult(this->chessboard, i, this->options.mergeShards, shard)){
+			std::cerr << "The result of shard " << i << " is missing." << std::endl;
+			return false;
+		}
+		result += shard;
+	}
+	this->report(result);
+	return true;
 }
 
 /**
   * @brief  Calculate the result based on each sub result for each parallel_for instance.
   * @param 	output The individual output of the parallel_for instances
-  * @retval None
+  * @param 	base   The results that were known before the parallel_for instances
+  * @retval The merged result
   */
-void LongestUncrossedKnightsPath::collectAndExportResults(std::vector<OutputData>& output){
-	//Take the calcuates from the start optimization into consideration
-	longestPathLength = startOptimization.longestPathLength;
-	longestPathCount = startOptimization.longestPathCount;
-	longestPathBoard = startOptimization.longestPathBoard;
+OutputData LongestUncrossedKnightsPath::collectAndExportResults(std::vector<OutputData>& output, const OutputData& base){
+	//Take the known results from the start optimization or the checkpoint into consideration
+	OutputData result = base;
 	
 	//Iterate over all outputs
 	for(int i=0; i<output.size(); i++){
-		if(output[i].longestPathLength == longestPathLength){
-			longestPathCount += output[i].longestPathCount;
-		}else if(output[i].longestPathLength > longestPathLength){
-			longestPathCount = output[i].longestPathCount;
-			longestPathLength = output[i].longestPathLength;
-			longestPathBoard = output[i].longestPathBoard;
-		}
+		result += output[i];
 	}
+	this->report(result);
+	return result;
+}
 
-	std::cout << "Longest path is " << (int) longestPathLength << " with " << (int) longestPathCount << " equal length occurrences." << std::endl;
+/**
+  * @brief  Stores the final result and prints it.
+  * @param 	result The final result
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::report(const OutputData& result){
+	longestPathLength = result.longestPathLength;
+	longestPathCount = result.longestPathCount;
+	longestPathBoard = result.longestPathBoard;
+	witnessCount = result.witnessCount;
+	PruningStats reachabilityStats = result.reachabilityStats;
+
+	if(this->options.reachability > 0){
+		std::cout << "Reachability pruning cut " << reachabilityStats.pruned << " of " << reachabilityStats.checked << " checked nodes." << std::endl;
+	}
+	if(this->options.minLength > 0){
+		this->reportWitness();
+	}else if(this->options.countPaths){
+		std::cout << "Longest path is " << (int) longestPathLength << " with " << (int) longestPathCount << " equal length occurrences." << std::endl;
+	}else{
+		std::cout << "Longest path is " << (int) longestPathLength << "." << std::endl;
+	}
+}
+
+/**
+  * @brief  Prints whether a path with at least the minimum length exists, or how many there are with --count-witnesses.
+  *         A search that was stopped by the deadline without a witness didn't prove that there is none.
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::reportWitness() const{
+	uint16_t minLength = this->options.minLength;
+	if(witnessCount == 0){
+		if(!this->complete){
+			std::cout << "No path with at least " << minLength << " fields was found." << std::endl;
+		}else{
+			std::cout << "There is no path with at least " << minLength << " fields." << std::endl;
+		}
+	}else if(this->options.countWitnesses){
+		std::cout << "There are " << witnessCount << " paths with at least " << minLength << " fields, the longest has " << (int) longestPathLength << " fields." << std::endl;
+	}else{
+		std::cout << "A path with at least " << minLength << " fields exists, it has " << (int) longestPathLength << " fields." << std::endl;
+	}
 }
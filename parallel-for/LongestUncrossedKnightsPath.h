@@ -5,16 +5,25 @@
 #include <stdint.h>
 #include <queue>
 #include <thread>
+#include <chrono>
 
 #include "tbb/parallel_for.h"
 #include "tbb/blocked_range.h"
 #include "tbb/partitioner.h"
 #include "tbb/task_scheduler_init.h"
+#include "tbb/parallel_do.h"
+#include "tbb/combinable.h"
 
 #include "Chessboard.h"
 #include "LUKPData.h"
 #include "LUKPStartOptimization.h"
 #include "LUKPIterator.h"
+#include "SearchOptions.h"
+#include "FileExporter.h"
+#include "Checkpoint.h"
+#include "LUKPCoordinator.h"
+#include "AnytimeSearch.h"
+#include "LUKPEmbedding.h"
 
 class LongestUncrossedKnightsPath {
  
@@ -22,20 +31,42 @@ private:
 	uint16_t n_thread_limit = 0;
 
 	Chessboard chessboard;
+	SearchOptions options;
 	LUKPStartOptimization startOptimization;
 
-	void collectAndExportResults(std::vector<OutputData>&);
+	//A longest length that is known before the search, e.g. from the result cache
+	uint16_t knownLength = 0;
+
+	//A path that is known before the search, e.g. embedded from a smaller board. Its length is a lower bound.
+	OutputData incumbent;
+
+	//false: The deadline stopped the last search, its result is a lower bound
+	bool complete = true;
+
+	OutputData collectAndExportResults(std::vector<OutputData>&, const OutputData&);
+	void reportWitness() const;
 
 public:
 	uint16_t longestPathLength = 0;
     uint16_t longestPathCount = 0;
    	Chessboard longestPathBoard;
+	uint64_t witnessCount = 0;
 	
 	LongestUncrossedKnightsPath(uint8_t, uint8_t);
 	virtual ~LongestUncrossedKnightsPath();
 
 	void setThreadLimit(uint16_t);
+	void setSearchOptions(const SearchOptions&);
+	void setKnownLength(uint16_t);
+	bool setIncumbent(const Chessboard&);
+	void addIncumbent(OutputData&) const;
+	uint16_t getInitialBound(const OutputData&) const;
+	OutputData getResult() const;
+	bool isComplete() const;
+	void report(const OutputData&);
 	void run();
+	std::vector<ThreadInputData> createStartConfigurations(uint32_t, OutputData&);
+	bool mergeShards();
 };
 
 #endif /* LONGESTUNCROSSEDKNIGHTSPATH_H */
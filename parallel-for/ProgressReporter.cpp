@@ -0,0 +1,156 @@
+#include "ProgressReporter.h"
+
+static std::atomic<uint64_t> nextId{0};
+
+/**
+  * @brief  Constructor of a reporter, the background thread isn't started yet.
+  */
+ProgressReporter::ProgressReporter() : id(++nextId) { }
+
+/**
+  * @brief  Destructor, stops the background thread if it is still running.
+  */
+ProgressReporter::~ProgressReporter() {
+  this->stop();
+}
+
+/**
+  * @brief  Starts the background thread that prints the progress periodically.
+  * @param  interval The time between two progress lines in seconds
+  * @param  units    The number of work units known at the start
+  * @param  estimate The estimated number of nodes of all work units, 0 if they aren't estimated
+  * @retval None
+  */
+void ProgressReporter::start(uint32_t interval, uint64_t units, double estimate) {
+  this->totalUnits = units;
+  this->totalEstimate = estimate;
+  this->running = true;
+  this->writer = std::thread([this, interval]() {
+    auto begin = std::chrono::steady_clock::now();
+    double lastSeconds = 0;
+    uint64_t lastNodes = 0;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while(!this->stopped.wait_for(lock, std::chrono::seconds(interval), [this]() { return !this->running; })) {
+      std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - begin;
+      uint64_t nodes = this->countNodes();
+      this->print(elapsed_seconds.count(), (nodes - lastNodes) / (elapsed_seconds.count() - lastSeconds));
+      lastSeconds = elapsed_seconds.count();
+      lastNodes = nodes;
+    }
+  });
+}
+
+/**
+  * @brief  Stops the background thread.
+  * @retval None
+  */
+void ProgressReporter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->running = false;
+  }
+  this->stopped.notify_all();
+  if(this->writer.joinable()) {
+    this->writer.join();
+  }
+}
+
+/**
+  * @brief  Returns the node counter of the calling thread. It is created on the first call of a thread.
+  *         The caller should keep the reference, because the lookup isn't meant for every node.
+  * @retval The counter of the calling thread
+  */
+ThreadProgress& ProgressReporter::local() {
+  thread_local uint64_t owner = 0;
+  thread_local ThreadProgress* counter = nullptr;
+  if(owner != this->id) {
+    std::lock_guard<std::mutex> lock(this->threadsMutex);
+    this->threads.emplace_back();
+    owner = this->id;
+    counter = &this->threads.back();
+  }
+  return *counter;
+}
+
+/**
+  * @brief  Adds work units that were created during the search, e.g. by the dynamic splitting.
+  * @param  units The number of new work units
+  * @retval None
+  */
+void ProgressReporter::addUnits(uint64_t units) {
+  this->totalUnits += units;
+}
+
+/**
+  * @brief  Marks a work unit as finished.
+  * @param  nodes    The nodes of the unit that weren't counted by a thread counter
+  * @param  estimate The estimated number of nodes of the unit, 0 if it isn't estimated
+  * @retval None
+  */
+void ProgressReporter::finishUnit(uint64_t nodes, double estimate) {
+  this->finishedUnits++;
+  this->finishedNodes += nodes;
+  double seen = this->finishedEstimate;
+  while(!this->finishedEstimate.compare_exchange_weak(seen, seen + estimate));
+}
+
+/**
+  * @brief  Merges paths that were found into the longest paths so far.
+  * @param  length The length of the paths
+  * @param  count  The number of paths
+  * @retval None
+  */
+void ProgressReporter::mergeLongest(uint16_t length, uint64_t count) {
+  uint64_t seen = this->longest;
+  uint64_t merged;
+  do {
+    uint16_t seenLength = seen >> 48;
+    if(length < seenLength) return;
+    merged = length > seenLength ? ((uint64_t) length << 48 | count) : seen + count;
+  } while(!this->longest.compare_exchange_weak(seen, merged));
+}
+
+/**
+  * @brief  Replaces the longest paths so far, for a search that merges its paths itself.
+  * @param  length The longest length
+  * @param  count  The number of paths of this length
+  * @retval None
+  */
+void ProgressReporter::setLongest(uint16_t length, uint64_t count) {
+  this->longest = (uint64_t) length << 48 | count;
+}
+
+/**
+  * @brief  Sums the nodes of all thread counters and of the finished units.
+  * @retval The visited nodes so far
+  */
+uint64_t ProgressReporter::countNodes() {
+  uint64_t nodes = this->finishedNodes;
+  std::lock_guard<std::mutex> lock(this->threadsMutex);
+  for(const ThreadProgress& thread : this->threads) {
+    nodes += thread.nodes.load(std::memory_order_relaxed);
+  }
+  return nodes;
+}
+
+/**
+  * @brief  Prints a progress line to stderr.
+  * @param  seconds The elapsed time of the search
+  * @param  rate    The visited nodes per second since the last line
+  * @retval None
+  */
+void ProgressReporter::print(double seconds, double rate) {
+  uint64_t units = this->finishedUnits;
+  uint64_t total = this->totalUnits;
+  double estimate = this->totalEstimate;
+  double done = estimate > 0 ? this->finishedEstimate / estimate : (total > 0 ? (double) units / total : 0);
+  uint64_t longest = this->longest;
+
+  std::cerr << "Progress: " << units << " of " << total << " units after " << (uint64_t) seconds << " s, " << (uint64_t) rate << " nodes/s, ";
+  std::cerr << "longest path " << (longest >> 48) << " (" << (longest & 0xFFFFFFFFFFFF) << " times), ";
+  if(done > 0) {
+    std::cerr << (int) (100 * done) << "% done, about " << (uint64_t) (seconds * (1 - done) / done) << " s left" << std::endl;
+  }else{
+    std::cerr << "no estimate of the remaining time yet" << std::endl;
+  }
+}
@@ -0,0 +1,21 @@
+#ifndef PRUNINGSTATS_H
+#define PRUNINGSTATS_H
+
+#include "stdint.h"
+
+/**
+ * Data class that counts the nodes that were checked by the reachability pruning and the nodes that were cut off.
+ */
+class PruningStats {
+public:
+	uint64_t checked = 0;
+	uint64_t pruned = 0;
+
+	PruningStats& operator+=(const PruningStats& other) {
+		this->checked += other.checked;
+		this->pruned += other.pruned;
+		return *this;
+	}
+};
+
+#endif /* PRUNINGSTATS_H */
@@ -0,0 +1,137 @@
+#include "ResultCache.h"
+
+/**
+  * @brief  Constructor of the cache. The file is stored next to the paths.
+  */
+ResultCache::ResultCache() : filename("./paths/results.cache") { }
+
+/**
+  * @brief  Reads the results of the file. A missing file is an empty cache.
+  * @retval None
+  */
+void ResultCache::load() {
+  this->entries.clear();
+  std::ifstream file(this->filename);
+  std::string line;
+  while(std::getline(file, line)) {
+    std::istringstream stream(line);
+    Entry entry;
+    int width = 0, height = 0;
+    stream >> width >> height >> entry.result.longestPathLength >> entry.result.longestPathCount;
+    LUKPSerializer::readOptions(stream, entry.options);
+    entry.result.longestPathBoard = LUKPSerializer::readBoard(stream);
+    if(stream.fail()) continue;
+
+    entry.width = width;
+    entry.height = height;
+    this->entries.push_back(entry);
+  }
+}
+
+/**
+  * @brief  Writes all results. The file is written to a temporary file first and renamed, so a crash while writing keeps the previous cache.
+  * @retval None
+  */
+void ResultCache::save() const {
+  std::string temporary = this->filename + ".tmp";
+  std::ofstream file(temporary);
+  for(const Entry& entry : this->entries) {
+    file << (int) entry.width << " " << (int) entry.height << " " << entry.result.longestPathLength << " " << entry.result.longestPathCount << " ";
+    LUKPSerializer::writeOptions(file, entry.options);
+    file << " ";
+    LUKPSerializer::writeBoard(file, entry.result.longestPathBoard);
+    file << std::endl;
+  }
+  file.close();
+
+  std::rename(temporary.c_str(), this->filename.c_str());
+}
+
+/**
+  * @brief  Searches a result that answers a search of a board size with the given options. A result with the number of
+  *         paths also answers a search without it, but the number of distinct cycles (-u) and of all paths are different results.
+  * @param  m       The width of the board
+  * @param  n       The height of the board
+  * @param  options The options of the search
+  * @param  result  The result that was found
+  * @retval true:   A result was found
+  *         false:  The board size needs to be searched
+  */
+bool ResultCache::find(uint8_t m, uint8_t n, const SearchOptions& options, OutputData& result) const {
+  for(const Entry& entry : this->entries) {
+    if(entry.width == m && entry.height == n && entry.options.canonical == options.canonical && (entry.options.countPaths || !options.countPaths)) {
+      result = entry.result;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+  * @brief  Returns the longest length of a board size that is known from any result of the cache.
+  * @param  m  The width of the board
+  * @param  n  The height of the board
+  * @retval The longest length, 0 if the board size isn't in the cache
+  */
+uint16_t ResultCache::getKnownLength(uint8_t m, uint8_t n) const {
+  uint16_t length = 0;
+  for(const Entry& entry : this->entries) {
+    if(entry.width == m && entry.height == n && entry.result.longestPathLength > length) {
+      length = entry.result.longestPathLength;
+    }
+  }
+  return length;
+}
+
+/**
+  * @brief  Returns the result with the longest path that fits into a board, as it is or transposed.
+  *         The board size itself is included, its path fits at the offset 0.
+  * @param  m      The width of the board
+  * @param  n      The height of the board
+  * @param  entry  Returns the result
+  * @retval true:   A path that fits was found
+  *         false:  No result of the cache fits
+  */
+bool ResultCache::findEmbeddable(uint8_t m, uint8_t n, Entry& entry) const {
+  bool found = false;
+  for(const Entry& candidate : this->entries) {
+    if(LUKPEmbedding::fits(candidate.width, candidate.height, m, n) && candidate.result.longestPathLength > (found ? entry.result.longestPathLength : 0)) {
+      entry = candidate;
+      found = true;
+    }
+  }
+  return found;
+}
+
+/**
+  * @brief  Stores the result of a complete search. A previous result of the board size with the same options is replaced.
+  *         The file is read again before, so results that other processes stored in the meantime are kept.
+  * @param  m       The width of the board
+  * @param  n       The height of the board
+  * @param  options The options of the search
+  * @param  result  The result of the search
+  * @retval None
+  */
+void ResultCache::store(uint8_t m, uint8_t n, const SearchOptions& options, const OutputData& result) {
+  this->load();
+
+  Entry entry;
+  entry.width = m;
+  entry.height = n;
+  entry.options = options;
+  entry.result.longestPathLength = result.longestPathLength;
+  entry.result.longestPathCount = options.countPaths ? result.longestPathCount : 0;
+  entry.result.longestPathBoard = result.longestPathBoard;
+
+  bool replaced = false;
+  for(Entry& other : this->entries) {
+    if(other.width == m && other.height == n && other.options.canonical == options.canonical && other.options.countPaths == options.countPaths) {
+      other = entry;
+      replaced = true;
+    }
+  }
+  if(!replaced) {
+    this->entries.push_back(entry);
+  }
+  this->save();
+}
@@ -0,0 +1,56 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "stdint.h"
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Chessboard.h"
+#include "LUKPData.h"
+#include "LUKPSerializer.h"
+#include "SearchOptions.h"
+#include "LUKPEmbedding.h"
+
+/**
+ * Stores the results of finished searches in a file, so a known board size is answered without a search.
+ * A result is only valid for the options that change it: with -o the number of paths isn't known and with -u
+ * the number of distinct cycles is counted. The longest length doesn't depend on the options, so every result
+ * of a board size is a bound for the pruning of a search with other options. The paths of smaller boards fit
+ * into larger ones, so they are a bound for the larger boards, see LUKPEmbedding.
+ * Each line of the file is a result: width height length count options board
+ */
+class ResultCache {
+
+public:
+	/**
+	 * Data class that stores a result of the cache with the options it was searched with.
+	 */
+	class Entry {
+	public:
+		uint8_t width = 0;
+		uint8_t height = 0;
+		SearchOptions options;
+		OutputData result;
+	};
+
+private:
+	std::string filename;
+	std::vector<Entry> entries;
+
+	void save() const;
+
+public:
+	ResultCache();
+
+	void load();
+	bool find(uint8_t, uint8_t, const SearchOptions&, OutputData&) const;
+	uint16_t getKnownLength(uint8_t, uint8_t) const;
+	bool findEmbeddable(uint8_t, uint8_t, Entry&) const;
+	void store(uint8_t, uint8_t, const SearchOptions&, const OutputData&);
+};
+
+#endif /* RESULTCACHE_H */
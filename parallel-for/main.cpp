@@ -8,18 +8,50 @@
 
 #include "LongestUncrossedKnightsPath.h"
 #include "FileExporter.h"
+#include "LUKPWorker.h"
+#include "LUKPBatch.h"
+#include "ResultCache.h"
 
-void get_args(int, char*[], uint8_t&, uint8_t&, uint16_t&);
+bool get_args(int, char*[], uint8_t&, uint8_t&, uint16_t&, SearchOptions&);
 
 void err_abort (const char*);
 
 int main(int argc, char* argv[]) {
     
-    uint8_t m = 0, n = 0, x = 0, y = 0; uint16_t t = 0;
-    if(argc == (4+1) || argc == (6+1)){
-        get_args(argc, argv, m, n, t);        
-    }else{
-        err_abort("Valid are: \nWith all start fields: -m 8 -n 8\nWith all start fields and limited threads: -m 8 -n 8 -t 1");
+    uint8_t m = 0, n = 0; uint16_t t = 0;
+    SearchOptions options;
+    if(!get_args(argc, argv, m, n, t, options)){
+        err_abort("Valid are: \nWith all start fields: -m 8 -n 8\nWith all start fields and limited threads: -m 8 -n 8 -t 1\nOptional: -c (copy the board for every move instead of in-place backtracking)\n          -b (always use the byte matrix instead of the bitboard for boards up to 64 fields)\n          -g (always use the generic kernel instead of the kernels specialised for a board size)\n          -p (prune subtrees that can't beat the longest path found so far)\n          -o (with -p: only search one longest path, the number of longest paths is not counted)\n          -r 2 (every 2 plies abandon paths that can't return to the root anymore)\n          -u (search each cycle only once from its smallest field, counts the distinct cycles)\n          -s 16 (give the moves of paths with less than 16 fields back to idle threads)\n          -e 32 (estimate the subtree sizes with 32 random probes, split the largest and start them largest first)\n          -k 600 (write a checkpoint every 600 seconds)\n          --resume (continue from the checkpoint of the board size)\n          --coordinator 5555 (distribute the start configurations to worker processes that connect to port 5555)\n          --shard 2/8 (only search the third of 8 shards and write its result to a file)\nAs worker:   --worker localhost:5555 (-t 4)\nMerge shards: -m 8 -n 8 --merge 8\nBatch:       --batch 4x4-7x7,5x9 (search all board sizes in one thread pool, smallest first)\nCache:       --cache (answer known board sizes from paths/results.cache and store new results there)\nProgress:    --progress 60 (print the progress to stderr every 60 seconds)\nDeadline:    --deadline 3600 (stop after 3600 seconds with the longest path so far)\nLower bound: --lower-bound 50 (with -p: a closed path of length 50 is known, e.g. from the heuristic engine)\nTarget:      --min-length 50 (only search paths with at least 50 fields, stops at the first one)\n             --count-witnesses (with --min-length: count all paths with at least the minimum length)");
+    }
+    if(options.minLength > 0 && (!options.coordinatorAddress.empty() || !options.batchSizes.empty() || options.coordinatorPort > 0 || options.shardCount > 0 || options.mergeShards > 0 || options.checkpointInterval > 0 || options.resume || options.cache)){
+        err_abort("The minimum length can't be combined with the distributed mode, the batch, shards, checkpoints or the cache.");
+    }
+    if(!options.coordinatorAddress.empty()){
+        //The worker gets the board and the options from the coordinator
+        size_t separator = options.coordinatorAddress.rfind(':');
+        if(separator == std::string::npos){
+            err_abort("The address of the coordinator needs to be given as host:port.");
+        }
+        std::string host = options.coordinatorAddress.substr(0, separator);
+        uint16_t port = strtol(options.coordinatorAddress.substr(separator + 1).c_str(), NULL, 10);
+        LUKPWorker worker(host, port, t > 0 ? t : std::thread::hardware_concurrency());
+        worker.run();
+        return 0;
+    }
+    if(!options.batchSizes.empty()){
+        std::vector<std::pair<uint8_t, uint8_t>> sizes;
+        if(!LUKPBatch::parseSizes(options.batchSizes, sizes)){
+            err_abort("The board sizes of the batch need to be given as 5x6 or as range 4x4-7x7, separated by commas.");
+        }
+        if(options.splitDepth > 0 || options.checkpointInterval > 0 || options.resume || options.coordinatorPort > 0 || options.shardCount > 0 || options.mergeShards > 0 || options.deadline > 0 || options.lowerBound > 0){
+            err_abort("The batch can't be combined with the splitting, checkpoints, the distributed mode, shards, a deadline or a lower bound.");
+        }
+        auto start = std::chrono::system_clock::now();
+        LUKPBatch batch(options, t);
+        batch.run(sizes);
+        std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+        std::cout << "The calculation took " << elapsed_seconds.count() << " seconds." << std::endl;
+        return 0;
     }
     if((m < 4 || n < 4) &&  (m + n) < 8){
         err_abort("Calculation only works from boards with min size 3x5 or 4x4.");
@@ -29,29 +61,119 @@ int main(int argc, char* argv[]) {
 
     LongestUncrossedKnightsPath algorithmn(m, n);
     algorithmn.setThreadLimit(t);
+    algorithmn.setSearchOptions(options);
 
     std::cout << "Running algorithmn over all fields on a " << (int) m << "x" << (int) n << " board with " << (int) (t > 0 ? t: std::thread::hardware_concurrency()) << " threads." << std::endl;
-    algorithmn.run();
+    //A shard only searches a part of the board, so its result isn't stored
+    ResultCache cache;
+    OutputData cached;
+    if(options.cache){
+        cache.load();
+    }
+    if(options.cache && options.shardCount == 0 && cache.find(m, n, options, cached)){
+        std::cout << "The result is known from the cache." << std::endl;
+        algorithmn.report(cached);
+    }else{
+        uint16_t knownLength = options.lowerBound;
+        if(options.cache){
+            knownLength = std::max(knownLength, cache.getKnownLength(m, n));
+        }
+        algorithmn.setKnownLength(knownLength);
+        //The longest path of the cache that fits into the board is the first incumbent
+        ResultCache::Entry smaller;
+        if(options.cache && cache.findEmbeddable(m, n, smaller) && algorithmn.setIncumbent(smaller.result.longestPathBoard)){
+            std::cout << "Starting with the path of length " << smaller.result.longestPathLength << " of the " << (int) smaller.width << "x" << (int) smaller.height << " board." << std::endl;
+        }
+        if(options.mergeShards > 0){
+            if(!algorithmn.mergeShards()){
+                err_abort("The result files of all shards are needed for the merge.");
+            }
+        }else{
+            algorithmn.run();
+        }
+        if(options.cache && options.shardCount == 0 && algorithmn.isComplete()){
+            cache.store(m, n, options, algorithmn.getResult());
+        }
+    }
 
     auto end = std::chrono::system_clock::now();
     std::chrono::duration<double> elapsed_seconds = end-start;
 
 	FileExporter fileExporter;
-	fileExporter.exportPath(algorithmn.longestPathBoard, 1);
+	//With a minimum length only a witness is exported, a shorter path doesn't answer the question
+	if(algorithmn.longestPathLength > 0 && (options.minLength == 0 || algorithmn.witnessCount > 0)){
+		fileExporter.exportPath(algorithmn.longestPathBoard, 1);
+	}
 
     std::cout << "The calculation took " << elapsed_seconds.count() << " seconds." << std::endl;
 }
 
-void get_args(int argc, char *argv[], uint8_t &m, uint8_t &n, uint16_t& t) {
-    for(int i=1; i<argc; i+=2) {
-        if(strcmp(argv[i], "-m") == 0) {
-            m = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-n") == 0) {
-            n = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-t") == 0) {
-            t = strtol(argv[i+1], NULL, 10);
+/**
+  * @brief  Parses the command line arguments. Options with a value are given as pairs (-m 8), flags are given alone (-c).
+  * @retval true:   The arguments are valid
+  *         false:  An argument is unknown or the board size is missing
+  */
+bool get_args(int argc, char *argv[], uint8_t &m, uint8_t &n, uint16_t& t, SearchOptions& options) {
+    for(int i=1; i<argc; i++) {
+        bool hasValue = (i+1 < argc);
+        if(strcmp(argv[i], "-m") == 0 && hasValue) {
+            m = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-n") == 0 && hasValue) {
+            n = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-t") == 0 && hasValue) {
+            t = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-c") == 0) {
+            options.inPlace = false;
+        } else if(strcmp(argv[i], "-b") == 0) {
+            options.bitboard = false;
+        } else if(strcmp(argv[i], "-g") == 0) {
+            options.specialised = false;
+        } else if(strcmp(argv[i], "-p") == 0) {
+            options.bound = true;
+        } else if(strcmp(argv[i], "-o") == 0) {
+            options.countPaths = false;
+        } else if(strcmp(argv[i], "-r") == 0 && hasValue) {
+            options.reachability = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-u") == 0) {
+            options.canonical = true;
+        } else if(strcmp(argv[i], "-e") == 0 && hasValue) {
+            options.estimateProbes = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-k") == 0 && hasValue) {
+            options.checkpointInterval = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--coordinator") == 0 && hasValue) {
+            options.coordinatorPort = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--worker") == 0 && hasValue) {
+            options.coordinatorAddress = argv[++i];
+        } else if(strcmp(argv[i], "--shard") == 0 && hasValue) {
+            if(sscanf(argv[++i], "%hu/%hu", &options.shardIndex, &options.shardCount) != 2 || options.shardIndex >= options.shardCount) {
+                return false;
+            }
+        } else if(strcmp(argv[i], "--merge") == 0 && hasValue) {
+            options.mergeShards = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--batch") == 0 && hasValue) {
+            options.batchSizes = argv[++i];
+        } else if(strcmp(argv[i], "--progress") == 0 && hasValue) {
+            options.progressInterval = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--deadline") == 0 && hasValue) {
+            options.deadline = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--lower-bound") == 0 && hasValue) {
+            options.lowerBound = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--min-length") == 0 && hasValue) {
+            options.minLength = strtol(argv[++i], NULL, 10);
+            options.bound = true;
+        } else if(strcmp(argv[i], "--count-witnesses") == 0) {
+            options.countWitnesses = true;
+        } else if(strcmp(argv[i], "--cache") == 0) {
+            options.cache = true;
+        } else if(strcmp(argv[i], "--resume") == 0) {
+            options.resume = true;
+        } else if(strcmp(argv[i], "-s") == 0 && hasValue) {
+            options.splitDepth = strtol(argv[++i], NULL, 10);
+        } else {
+            return false;
         }
     }
+    return (m > 0 && n > 0) || !options.coordinatorAddress.empty() || !options.batchSizes.empty();
 }
 
 void err_abort (const char *str){ 
@@ -0,0 +1,29 @@
+#!/bin/bash
+# Compares the results of the dynamic splitting with the results of the plain search.
+# The split off start configurations are converted from the board of the iterator, so all
+# of them need to keep their blocked fields (e.g. with canonical roots).
+# Usage: ./regression_check.sh [./path]
+
+BINARY=${1:-./path}
+FAILED=0
+
+count() {
+  "$BINARY" "$@" | grep "Longest path"
+}
+
+for SIZE in "5 5" "5 6" "6 6" "7 7"; do
+  set -- $SIZE
+  for FLAGS in "" "-u" "-g" "-u -g"; do
+    EXPECTED=$(count -m $1 -n $2 $FLAGS)
+    ACTUAL=$(count -m $1 -n $2 $FLAGS -s 8 -t 4)
+    if [ "$EXPECTED" != "$ACTUAL" ]; then
+      echo "FAILED: -m $1 -n $2 $FLAGS -s 8: '$ACTUAL', expected '$EXPECTED'"
+      FAILED=1
+    fi
+  done
+done
+
+if [ $FAILED -eq 0 ]; then
+  echo "All checks passed."
+fi
+exit $FAILED
@@ -0,0 +1,100 @@
+#include "AnytimeSearch.h"
+
+/**
+  * @brief  Destructor, stops the background thread if it is still running.
+  */
+AnytimeSearch::~AnytimeSearch() {
+  this->stop();
+}
+
+/**
+  * @brief  Starts the background thread that marks the deadline as expired.
+  * @param  seconds The time until the deadline
+  * @retval None
+  */
+void AnytimeSearch::start(uint32_t seconds) {
+  this->running = true;
+  this->timer = std::thread([this, seconds]() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(!this->stopped.wait_for(lock, std::chrono::seconds(seconds), [this]() { return !this->running; })) {
+      this->expired = true;
+    }
+  });
+}
+
+/**
+  * @brief  Stops the background thread. If the search finished before the deadline, it isn't expired.
+  * @retval None
+  */
+void AnytimeSearch::stop() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->running = false;
+  }
+  this->stopped.notify_all();
+  if(this->timer.joinable()) {
+    this->timer.join();
+  }
+}
+
+/**
+  * @brief  Stops the search before the deadline, e.g. when a path of the target length is found.
+  *         The backtracking returns at the next node like at an expired deadline.
+  * @retval None
+  */
+void AnytimeSearch::stopEarly() {
+  this->stoppedEarly = true;
+  this->expired = true;
+}
+
+/**
+  * @brief  Adds work units to the search.
+  * @param  units The number of work units
+  * @retval None
+  */
+void AnytimeSearch::addUnits(uint64_t units) {
+  this->units += units;
+}
+
+/**
+  * @brief  Marks a work unit as completely searched. It needs to be called only if the deadline didn't stop its backtracking.
+  * @retval None
+  */
+void AnytimeSearch::finishUnit() {
+  this->finishedUnits++;
+}
+
+/**
+  * @brief  Writes a path to paths/MxN_best.path, if it is longer than the path that is already written.
+  * @param  cboard The chessboard of the closed path
+  * @retval None
+  */
+void AnytimeSearch::offerPath(const Chessboard& cboard) {
+  if(cboard.getLength() <= this->writtenLength.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->pathMutex);
+  if(cboard.getLength() <= this->writtenLength) {
+    return;
+  }
+  this->writtenLength = cboard.getLength();
+
+  Chessboard path = cboard;
+  FileExporter fileExporter;
+  fileExporter.exportBestPath(path);
+}
+
+/**
+  * @brief  Prints whether the search was stopped by the deadline and how many work units were searched completely.
+  * @retval None
+  */
+void AnytimeSearch::report() const {
+  if(!this->isExpired() || this->isStoppedEarly()) {
+    return;
+  }
+  uint64_t total = this->units;
+  uint64_t finished = this->finishedUnits;
+  std::cout << "The deadline stopped the search, " << finished << " of " << total << " work units (" << (total > 0 ? 100.0 * finished / total : 0) << "%) were searched completely." << std::endl;
+  std::cout << "The longest path is a lower bound and the number of paths is incomplete." << std::endl;
+}
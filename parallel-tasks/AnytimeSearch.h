@@ -0,0 +1,71 @@
+#ifndef ANYTIMESEARCH_H
+#define ANYTIMESEARCH_H
+
+#include "stdint.h"
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "Chessboard.h"
+#include "FileExporter.h"
+
+/**
+ * The state of a search with a deadline. A background thread marks the deadline as expired, the backtracking checks
+ * the flag at every node and returns, so the search stops cleanly. The longest path so far is written to a file
+ * whenever it gets longer, so a killed search also leaves its best path behind. The finished work units tell how
+ * much of the search space was searched completely. A search for a path of a target length also stops with the
+ * flag as soon as it found one.
+ */
+class AnytimeSearch {
+
+private:
+	std::atomic<bool> expired{false};
+	std::atomic<bool> stoppedEarly{false};
+	std::atomic<uint64_t> units{0};
+	std::atomic<uint64_t> finishedUnits{0};
+
+	//The length of the path in the file, it is read without the lock to skip shorter paths
+	std::atomic<uint16_t> writtenLength{0};
+	std::mutex pathMutex;
+
+	std::thread timer;
+	std::mutex mutex;
+	std::condition_variable stopped;
+	bool running = false;
+
+public:
+	~AnytimeSearch();
+
+	void start(uint32_t);
+	void stop();
+
+	/**
+	  * @brief  Checks whether the deadline is reached. It is called at every node, so it only reads the flag.
+	  * @retval true:   The search needs to stop
+	  *         false:  The search continues
+	  */
+	inline bool isExpired() const {
+		return this->expired.load(std::memory_order_relaxed);
+	}
+
+	void stopEarly();
+
+	/**
+	  * @brief  Checks whether the search was stopped by stopEarly() instead of the deadline.
+	  * @retval true:   The search was stopped early
+	  *         false:  The search wasn't stopped or the deadline stopped it
+	  */
+	inline bool isStoppedEarly() const {
+		return this->stoppedEarly.load(std::memory_order_relaxed);
+	}
+
+	void addUnits(uint64_t);
+	void finishUnit();
+	void offerPath(const Chessboard&);
+	void report() const;
+};
+
+#endif /* ANYTIMESEARCH_H */
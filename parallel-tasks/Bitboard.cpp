@@ -0,0 +1,546 @@
+#include "Bitboard.h"
+
+#include <vector>
+
+/**
+  * @brief  Rotates a bitboard to the right, so that the bit of the given field becomes bit 0.
+  */
+static inline uint64_t rotateRight(uint64_t board, uint8_t field) {
+  return (board >> field) | (board << ((64 - field) & 63));
+}
+
+/**
+  * @brief  Default constructor
+  */
+Bitboard::Bitboard() : Bitboard(0, 0) { }
+
+/**
+  * @brief  Constructor of the bitboard. The board needs to have at most 64 fields.
+  * @param  m width
+  * @param  n height
+  * @see    fits()
+  */
+Bitboard::Bitboard(uint8_t m, uint8_t n)
+: width(m), height(n), crossing(getCrossingTable(m)), targets(getTargetTable(m, n)), onBoard(getOnBoardTable(m, n)), root(std::make_pair(0, 0)), length(0) { }
+
+/**
+  * @brief  Creates a bitboard with the same state as the given chessboard. The chessboard needs to have at most 64 fields.
+  *         Blocked fields (0b11111111) are only marked as occupied, so they don't count as connection.
+  * @param  cboard The chessboard to convert
+  */
+Bitboard::Bitboard(const Chessboard& cboard) : Bitboard(cboard.getWidth(), cboard.getHeight()) {
+  for(uint8_t y = 0; y < this->height; y++) {
+    for(uint8_t x = 0; x < this->width; x++) {
+      uint8_t moves = cboard.at(x + BORDER_OFFSET, y + BORDER_OFFSET);
+      if(moves == 0b11111111) {
+        this->occupied |= 1ULL << index(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+      }else if(moves != 0b00000000) {
+        this->updateField(moves, std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+      }
+    }
+  }
+  this->root = cboard.getRoot();
+  this->rootIndex = toIndex(this->root);
+  this->length = cboard.getLength();
+}
+
+/**
+  * @brief  Checks whether a board of the given size can be represented as bitboard.
+  * @param  m width
+  * @param  n height
+  * @retval true:   The board has at most 64 fields
+  *         false:  The board is too large
+  */
+bool Bitboard::fits(uint8_t m, uint8_t n) {
+  return m * n <= BITBOARD_MAX_FIELDS;
+}
+
+/**
+  * @brief  Converts the bitboard to a chessboard with the same state, e.g. to store or export a finished path.
+  * @retval The chessboard
+  */
+Bitboard::operator Chessboard() const {
+  Chessboard cboard(this->width, this->height);
+  for(uint8_t y = 0; y < this->height; y++) {
+    for(uint8_t x = 0; x < this->width; x++) {
+      std::pair<uint8_t, uint8_t> field = std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET);
+      uint8_t moves = this->at(field.first, field.second);
+      if(moves == 0b00000000) {
+        //Blocked fields are occupied without moves
+        if(this->isFieldReserved(field)) cboard.updateField(0b11111111, field);
+        continue;
+      }
+
+      if(field == this->root) {
+        cboard.setRoot(moves, field);
+      }else{
+        cboard.setField(moves, field);
+      }
+    }
+  }
+  return cboard;
+}
+
+/**
+  * @brief  Returns the crossing table for a board width. For each move and each direction d it contains the fields,
+  *         relative to the source field, where a move d would cross the given move. The relative positions are
+  *         stored modulo 64, which matches rotateRight(). The tables are calculated once for all widths.
+  * @param  m The width of the board
+  * @retval The table with 8x8 entries [move][direction]
+  */
+const uint64_t* Bitboard::getCrossingTable(uint8_t m) {
+  static const std::vector<uint64_t> tables = [] {
+    std::vector<uint64_t> t((BITBOARD_MAX_FIELDS + 1) * 64, 0);
+    for(int w = 0; w <= BITBOARD_MAX_FIELDS; w++) {
+      for(int move = 0; move < MOVE_COUNT; move++) {
+        for(int k = 0; k < NEIGHBOUR_COUNT; k++) {
+          int offset = MoveTable::neighbourDx[move][k] + MoveTable::neighbourDy[move][k] * w;
+          for(int d = 0; d < 8; d++) {
+            if((MoveTable::neighbourMask[move][k] & (1 << d)) != 0) {
+              t[w * 64 + move * 8 + d] |= 1ULL << ((offset + 64) & 63);
+            }
+          }
+        }
+      }
+    }
+    return t;
+  }();
+  return &tables[(m <= BITBOARD_MAX_FIELDS ? m : 0) * 64];
+}
+
+/**
+  * @brief  Returns the target table for a board size. For each field and move it contains the field index of the target,
+  *         or BITBOARD_OFF_BOARD if the move leaves the board. The tables are calculated once for all sizes that fit.
+  * @param  m The width of the board
+  * @param  n The height of the board
+  * @retval The table with 64x8 entries [field][move]
+  */
+const uint8_t* Bitboard::getTargetTable(uint8_t m, uint8_t n) {
+  static const std::vector<std::vector<uint8_t>> tables = [] {
+    std::vector<std::vector<uint8_t>> t((BITBOARD_MAX_FIELDS + 1) * (BITBOARD_MAX_FIELDS + 1));
+    for(int w = 0; w <= BITBOARD_MAX_FIELDS; w++) {
+      for(int h = 0; w * h <= BITBOARD_MAX_FIELDS && h <= BITBOARD_MAX_FIELDS; h++) {
+        std::vector<uint8_t>& table = t[w * (BITBOARD_MAX_FIELDS + 1) + h];
+        table.assign(BITBOARD_MAX_FIELDS * MOVE_COUNT, BITBOARD_OFF_BOARD);
+        for(int field = 0; field < w * h; field++) {
+          for(int move = 0; move < MOVE_COUNT; move++) {
+            int x = field % w + MoveTable::moveDx[move];
+            int y = field / w + MoveTable::moveDy[move];
+            if(x >= 0 && x < w && y >= 0 && y < h) { table[field * MOVE_COUNT + move] = y * w + x; }
+          }
+        }
+      }
+    }
+    return t;
+  }();
+  if(m * n > BITBOARD_MAX_FIELDS) { m = 0; n = 0; }
+  return tables[m * (BITBOARD_MAX_FIELDS + 1) + n].data();
+}
+
+/**
+  * @brief  Returns the on-board table for a board size. For each move it contains the bitboard of the fields whose target
+  *         of that move is on the board. The tables are calculated once from the target tables.
+  * @param  m The width of the board
+  * @param  n The height of the board
+  * @retval The table with 8 bitboards [move]
+  */
+const uint64_t* Bitboard::getOnBoardTable(uint8_t m, uint8_t n) {
+  static const std::vector<uint64_t> tables = [] {
+    std::vector<uint64_t> t((BITBOARD_MAX_FIELDS + 1) * (BITBOARD_MAX_FIELDS + 1) * MOVE_COUNT, 0);
+    for(int w = 0; w <= BITBOARD_MAX_FIELDS; w++) {
+      for(int h = 0; w * h <= BITBOARD_MAX_FIELDS && h <= BITBOARD_MAX_FIELDS; h++) {
+        const uint8_t* targets = getTargetTable(w, h);
+        for(int field = 0; field < w * h; field++) {
+          for(int move = 0; move < MOVE_COUNT; move++) {
+            if(targets[field * MOVE_COUNT + move] != BITBOARD_OFF_BOARD) {
+              t[(w * (BITBOARD_MAX_FIELDS + 1) + h) * MOVE_COUNT + move] |= 1ULL << field;
+            }
+          }
+        }
+      }
+    }
+    return t;
+  }();
+  if(m * n > BITBOARD_MAX_FIELDS) { m = 0; n = 0; }
+  return &tables[(m * (BITBOARD_MAX_FIELDS + 1) + n) * MOVE_COUNT];
+}
+
+/**
+  * @brief  Returns the bit index of a field.
+  * @param  field The position of the field (including the border offset)
+  * @retval The bit index
+  */
+uint8_t Bitboard::index(std::pair<uint8_t, uint8_t> field) const {
+  return (field.second - BORDER_OFFSET) * this->width + (field.first - BORDER_OFFSET);
+}
+
+/**
+  * @brief  Checks whether a position is inside of the board and not a border field.
+  * @param  field The position of the field (including the border offset)
+  * @retval true:   The field is on the board
+  *         false:  The field is a border field
+  */
+bool Bitboard::isOnBoard(std::pair<uint8_t, uint8_t> field) const {
+  return (uint8_t)(field.first - BORDER_OFFSET) < this->width && (uint8_t)(field.second - BORDER_OFFSET) < this->height;
+}
+
+/**
+  * @brief  Sets the moves to a field. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    getLength()
+  */
+void Bitboard::setField(uint8_t moves, std::pair<uint8_t, uint8_t> field) {
+  this->setField(moves, toIndex(field));
+}
+
+/**
+  * @brief  A method to update a field of the bitboard. This doesn't alter the path length.
+  * @param  moves The moves to set
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    setField()
+  */
+void Bitboard::updateField(uint8_t moves, std::pair<uint8_t, uint8_t> field) {
+  this->updateField(moves, toIndex(field));
+}
+
+/**
+  * @brief  Reverts a previous setField() call. Clears the moves of the field and decreases the path length by one.
+  * @param  field The coordinates of the field
+  * @retval None
+  * @see    setField()
+  */
+void Bitboard::unsetField(std::pair<uint8_t, uint8_t> field) {
+  this->unsetField(toIndex(field));
+}
+
+/**
+  * @brief  Sets a field as root. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  _root The coordinates of the root
+  * @retval None
+  * @see    setField()
+  */
+void Bitboard::setRoot(uint8_t moves, std::pair<uint8_t, uint8_t> _root) {
+  this->root = _root;
+  this->rootIndex = toIndex(_root);
+  this->setField(moves, _root);
+}
+
+/**
+  * @brief  Returns the moves of a field in the bit format. Border fields return 0b11111111 like on the chessboard.
+  * @param  x x-position (including the border offset)
+  * @param  y y-position (including the border offset)
+  * @retval Moves in given position
+  */
+uint8_t Bitboard::at(uint8_t x, uint8_t y) const {
+  return this->at(toIndex(std::make_pair(x, y)));
+}
+
+std::pair<uint8_t, uint8_t> Bitboard::getRoot() const {
+  return this->root;
+}
+
+/**
+  * @brief  Returns the width of the bitboard.
+  * @param  None
+  * @retval width
+  */
+uint8_t Bitboard::getWidth() const {
+  return this->width;
+}
+
+/**
+  * @brief  Returns the hight of the bitboard.
+  * @param  None
+  * @retval height
+  */
+uint8_t Bitboard::getHeight() const {
+  return this->height;
+}
+
+/**
+  * @brief  Returns the current paths length.
+  * @param  None
+  * @retval The length of the current path
+  */
+uint16_t Bitboard::getLength() const {
+  return this->length;
+}
+
+/**
+  * @brief  Prints the current bitboard to the console.
+  * @param  None
+  * @retval None
+  */
+void Bitboard::debug() const {
+  std::cout << "Bitboard [" << (int) this->getWidth() << "x" << (int) this->getHeight() << " | " << this->getLength() << "]" << std::endl;
+  for(uint8_t y = 0; y < this->getHeight(); y++) {
+    for(uint8_t x = 0; x < this->getWidth(); x++) {
+      uint8_t moves = this->at(x + BORDER_OFFSET, y + BORDER_OFFSET);
+      if(!moves) {
+        std::cout << "0        ";
+      }else{
+        std::cout << std::bitset<8>(moves) << " ";
+      }
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+/**
+  * @brief  Returns the target of a move from the knight. Does not alter the bitboard.
+  * @param  source  The current field of the knight
+  * @param  move    The move of the knight in the bit format
+  * @retval The target node position
+  */
+std::pair<uint8_t, uint8_t> Bitboard::doMove(std::pair<uint8_t, uint8_t> source, uint8_t move) const {
+  uint8_t i = MoveTable::index(move);
+  return std::make_pair(source.first + MoveTable::moveDx[i], source.second + MoveTable::moveDy[i]);
+}
+
+/**
+  * @brief  Rotates the move by 180 degrees.
+  * @param  move The move represented in the bit format
+  * @retval The rotated move in the bit format
+  */
+uint8_t Bitboard::rotate180(uint8_t move) const {
+  return (move << 4) | (move >> 4);
+}
+
+/**
+  * @brief  Checks if the given move finishes the path. Checks that the move isn't backwards.
+  * @param  source        The start position of the move
+  * @param  target        The target position of the move
+  * @param  outgoing_move The move represented in the bit format
+  * @retval true:   Node can be processed further
+  *         false:  Node cannot be processed further
+  */
+bool Bitboard::isFinishable(std::pair<uint8_t, uint8_t> source, std::pair<uint8_t, uint8_t> target, uint8_t outgoing_move) const {
+  return (target.first == root.first && target.second == root.second)
+      && !(source.first == root.first && source.second == root.second)
+      && !isConnectionCrossesEdge(source, outgoing_move);
+}
+
+/**
+  * @brief  Checks whether a field is already a part of the path. Border fields are always reserved.
+  * @param  field   The position of the field to check
+  * @retval true:   Node is already a part of the path or a border field
+  *         false:  Node is currently not a part of the path
+  */
+bool Bitboard::isFieldReserved(std::pair<uint8_t, uint8_t> field) const {
+  return this->isFieldReserved(toIndex(field));
+}
+
+/**
+  * @brief  Checks if the edge to the node crosses another edge.
+  * @param  source  The position of the node to check
+  * @param  move    The edge to check a possible crossing with
+  * @retval true:   The move crosses an existing connection
+  *         false:  The move doesn't cross an existing connection
+  * @see    isConnectionCrossesEdge(uint16_t, uint8_t)
+  */
+bool Bitboard::isConnectionCrossesEdge(std::pair<uint8_t, uint8_t> source, uint8_t move) const {
+  return this->isConnectionCrossesEdge(toIndex(source), move);
+}
+
+/**
+  * @brief  Converts a position to its field index.
+  * @param  field The position of the field (including the border offset)
+  * @retval The field index, BITBOARD_OFF_BOARD for border fields
+  */
+uint16_t Bitboard::toIndex(std::pair<uint8_t, uint8_t> field) const {
+  return isOnBoard(field) ? index(field) : BITBOARD_OFF_BOARD;
+}
+
+/**
+  * @brief  Converts a field index back to its position, e.g. for exporting or debugging.
+  * @param  i The field index
+  * @retval The position of the field (including the border offset)
+  */
+std::pair<uint8_t, uint8_t> Bitboard::toField(uint16_t i) const {
+  return std::make_pair(i % this->width + BORDER_OFFSET, i / this->width + BORDER_OFFSET);
+}
+
+/**
+  * @brief  Returns the field index of the root.
+  * @param  None
+  * @retval The field index of the root
+  */
+uint16_t Bitboard::getRootIndex() const {
+  return this->rootIndex;
+}
+
+/**
+  * @brief  Returns the moves of a field in the bit format. Fields outside of the board return 0b11111111 like on the chessboard.
+  * @param  i The field index
+  * @retval Moves in given field
+  */
+uint8_t Bitboard::at(uint16_t i) const {
+  if(i >= BITBOARD_OFF_BOARD) return 0b11111111;
+
+  uint8_t moves = 0b00000000;
+  for(uint8_t d = 0; d < 8; d++) {
+    moves |= ((this->edges[d] >> i) & 1) << d;
+  }
+  return moves;
+}
+
+/**
+  * @brief  Sets the moves to a field. Increases the path length of the path by one.
+  * @param  moves The moves to set
+  * @param  i     The field index
+  * @retval None
+  */
+void Bitboard::setField(uint8_t moves, uint16_t i) {
+  this->updateField(moves, i);
+  this->length++;
+}
+
+/**
+  * @brief  Updates the moves of a field. This doesn't alter the path length.
+  * @param  moves The moves to set
+  * @param  i     The field index
+  * @retval None
+  */
+void Bitboard::updateField(uint8_t moves, uint16_t i) {
+  uint64_t bit = 1ULL << i;
+  for(uint8_t d = 0; d < 8; d++) {
+    this->edges[d] = (this->edges[d] & ~bit) | ((uint64_t)((moves >> d) & 1) << i);
+  }
+  this->occupied = (this->occupied & ~bit) | ((uint64_t)(moves != 0b00000000) << i);
+}
+
+/**
+  * @brief  Reverts a previous setField() call. Clears the moves of the field and decreases the path length by one.
+  * @param  i The field index
+  * @retval None
+  */
+void Bitboard::unsetField(uint16_t i) {
+  this->updateField(0b00000000, i);
+  this->length--;
+}
+
+/**
+  * @brief  Returns the target of a move from the knight with one lookup in the target table.
+  * @param  source  The field index of the knight
+  * @param  move    The move of the knight in the bit format (exactly one bit set)
+  * @retval The field index of the target, BITBOARD_OFF_BOARD if the move leaves the board
+  */
+uint16_t Bitboard::doMove(uint16_t source, uint8_t move) const {
+  return this->targets[source * MOVE_COUNT + MoveTable::index(move)];
+}
+
+/**
+  * @brief  Checks if the given move finishes the path. Checks that the move isn't backwards.
+  * @param  source        The field index of the start of the move
+  * @param  target        The field index of the target of the move
+  * @param  outgoing_move The move represented in the bit format
+  * @retval true:   The move closes the path
+  *         false:  The move doesn't close the path
+  */
+bool Bitboard::isFinishable(uint16_t source, uint16_t target, uint8_t outgoing_move) const {
+  return target == this->rootIndex && source != this->rootIndex && !isConnectionCrossesEdge(source, outgoing_move);
+}
+
+/**
+  * @brief  Checks whether a field is already a part of the path with a single bit test. Fields outside of the board are always reserved.
+  * @param  i       The field index
+  * @retval true:   Node is already a part of the path or outside of the board
+  *         false:  Node is currently not a part of the path
+  */
+bool Bitboard::isFieldReserved(uint16_t i) const {
+  return (((this->occupied >> (i & 63)) | (i >> 6)) & 1) != 0;
+}
+
+/**
+  * @brief  Checks if the edge to the node crosses another edge. Each direction bitboard is rotated so the source field
+  *         becomes bit 0 and is then masked with the fields where that direction would cross the move.
+  *         The target of the move needs to be on the board, then all checked neighbours are on the board as well.
+  * @param  i       The field index of the node to check
+  * @param  move    The edge to check a possible crossing with (exactly one bit set)
+  * @retval true:   The move crosses an existing connection
+  *         false:  The move doesn't cross an existing connection
+  */
+bool Bitboard::isConnectionCrossesEdge(uint16_t i, uint8_t move) const {
+  const uint64_t* masks = this->crossing + MoveTable::index(move) * 8;
+
+  uint64_t conflicts = 0;
+  for(uint8_t d = 0; d < 8; d++) {
+    conflicts |= rotateRight(this->edges[d], i) & masks[d];
+  }
+  return conflicts != 0;
+}
+
+/**
+  * @brief  Returns the moves of a node that neither lead to a reserved field nor cross an edge, like Chessboard::getOpenMoves().
+  *         The bitboards answer both questions without neighbour reads, so the moves are calculated instead of stored.
+  *         The move to the root stays open if it doesn't cross an edge, so the path can be closed.
+  * @param  i       The field index of the node
+  * @retval The open moves in the bit format
+  */
+uint8_t Bitboard::getOpenMoves(uint16_t i) const {
+  uint8_t open = 0b00000000;
+  for(uint8_t d = 0; d < MOVE_COUNT; d++) {
+    uint8_t target = this->targets[i * MOVE_COUNT + d];
+    if(target == BITBOARD_OFF_BOARD || (target != this->rootIndex && isFieldReserved(target))) continue;
+    if(!isConnectionCrossesEdge(i, 1 << d)) { open |= 1 << d; }
+  }
+  return open;
+}
+
+/**
+  * @brief  Counts the free fields that the path can still visit over open moves, like Chessboard::countReachable().
+  *         First the open moves of all fields are calculated at once: the crossed fields of a move are the direction bitboards,
+  *         rotated by the offsets of the crossing table. Then the reachable fields are collected one knight move per step.
+  *         The offsets are exact, because only fields whose target is on the board are moved.
+  * @param  source  The field index to start from
+  * @param  limit   The number of fields after which the counting stops
+  * @retval The number of reachable free fields, at most limit. 0 if the root can't be reached.
+  */
+uint16_t Bitboard::countReachable(uint16_t source, uint16_t limit) const {
+  uint64_t open[MOVE_COUNT];
+  for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+    uint64_t crossed = 0;
+    for(uint8_t d = 0; d < 8; d++) {
+      for(uint64_t offsets = this->crossing[i * 8 + d]; offsets != 0; offsets &= offsets - 1) {
+        crossed |= rotateRight(this->edges[d], __builtin_ctzll(offsets));
+      }
+    }
+    open[i] = this->onBoard[i] & ~crossed;
+  }
+
+  uint64_t root = 1ULL << (this->rootIndex & 63);
+  uint64_t visited = 1ULL << source;
+  uint64_t reached = visited;
+  uint16_t count = 1;
+  bool closable = false;
+  while(reached != 0 && (count < limit || !closable)) {
+    uint64_t next = 0;
+    for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+      int8_t offset = MoveTable::moveDx[i] + MoveTable::moveDy[i] * this->width;
+      uint64_t moved = reached & open[i];
+      next |= offset > 0 ? moved << offset : moved >> -offset;
+    }
+    closable |= (next & root) != 0;
+    reached = next & ~(this->occupied | visited);
+    visited |= reached;
+    count = __builtin_popcountll(visited);
+  }
+
+  if(!closable) { return 0; }
+  return count < limit ? count : limit;
+}
+
+/**
+  * @brief  Checks whether the path can still be closed, like Chessboard::isRootReachable().
+  * @param  source  The field index to start from
+  * @retval true:   The root can be reached
+  *         false:  The root can't be reached anymore
+  */
+bool Bitboard::isRootReachable(uint16_t source) const {
+  return countReachable(source, 1) != 0;
+}
@@ -39,30 +39,59 @@ uint8_t FileExporter::getNextMove(Chessboard& cboard, uint8_t moves, uint8_t pre
   */
 void FileExporter::exportPath(Chessboard &chessboard, int number = 1)
 {
-    std::pair<uint8_t, uint8_t> root = chessboard.getRoot();
     //Create and open the file
     char filename[30];
     sprintf(filename, "./paths/%ix%i_%i.path", chessboard.getWidth(), chessboard.getHeight(), number);
     std::ofstream file(filename);
+    writePath(chessboard, file);
+    file.close();
+}
+
+/**
+  * @brief  This function stores the longest path so far of a search in ./paths/MxN_best.path. The file is written to a
+  *         temporary file first and renamed, so a search that is killed while writing keeps the previous path.
+  * @param  chessboard  The chessboard of the path to store
+  */
+void FileExporter::exportBestPath(Chessboard &chessboard)
+{
+    char filename[30];
+    sprintf(filename, "./paths/%ix%i_best.path", chessboard.getWidth(), chessboard.getHeight());
+    std::string temporary = std::string(filename) + ".tmp";
+    std::ofstream file(temporary);
+    writePath(chessboard, file);
+    file.close();
+
+    std::rename(temporary.c_str(), filename);
+}
+
+/**
+  * @brief  This function writes the board information and the fields of the path of a chessboard.
+  * @param  chessboard  The chessboard of the path to write
+  * @param  file        The file to write to
+  */
+void FileExporter::writePath(Chessboard &chessboard, std::ofstream &file)
+{
+    uint16_t root = chessboard.getRootIndex();
 
     //Write board information
     file << "m=" << (int) chessboard.getWidth() << std::endl;
     file << "n=" << (int) chessboard.getHeight() << std::endl;
 
     //Getting the first root move
-    uint8_t movingMove = getRootMove(chessboard.at(root.first, root.second));
+    uint8_t movingMove = getRootMove(chessboard.at(root));
 
     //Iterate over all moves
-    std::pair<uint8_t, uint8_t> currentField = root;
+    uint16_t currentField = root;
     uint16_t move = 0;
-    while (!(currentField.first == root.first && currentField.second == root.second) || move == 0)
+    while (currentField != root || move == 0)
     {
         //Write field
-        file << "(" << (int) currentField.first-2 << "," << (int) currentField.second-2 << ")" << std::endl;
+        std::pair<uint8_t, uint8_t> position = chessboard.toField(currentField);
+        file << "(" << (int) position.first-2 << "," << (int) position.second-2 << ")" << std::endl;
 
         //Get next field and the correct next move, that is not the backwards path
         currentField = chessboard.doMove(currentField, movingMove);
-        movingMove = getNextMove(chessboard, chessboard.at(currentField.first, currentField.second), movingMove);
+        movingMove = getNextMove(chessboard, chessboard.at(currentField), movingMove);
     
         //Break if there was an error with the path, to prevent an infinity loop and file wirting
         move++;
@@ -74,6 +103,4 @@ void FileExporter::exportPath(Chessboard &chessboard, int number = 1)
             file << "Path was not completed. Aborting!" << std::endl;
         }
     }
-    
-    file.close();
 }
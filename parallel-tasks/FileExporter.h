@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <cstdio>
 
 #include "Chessboard.h"
 
@@ -11,9 +13,11 @@ class FileExporter
 private:
     uint8_t getRootMove(uint8_t);
     uint8_t getNextMove(Chessboard&, uint8_t, uint8_t);
+    void writePath(Chessboard &, std::ofstream &);
 
 public:
     void exportPath(Chessboard &, int);
+    void exportBestPath(Chessboard &);
 };
 
 #endif /* FILEEXPORTER_H */
\ No newline at end of file
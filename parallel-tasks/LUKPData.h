@@ -8,6 +8,7 @@
 #include <tbb/atomic.h>
 
 #include "Chessboard.h"
+#include "PruningStats.h"
 
 class InputData {
 /**
@@ -19,11 +20,28 @@ public:
 };
 
 /**
- * Data class that stores the calcuation results to share across tasks.
+ * Data class that stores a node of the calibration probe: the board with the path so far and the field and move to continue from.
  */
-struct OutputData {
+struct ProbeNode {
 public:
 	Chessboard cboard;
+	uint16_t source;
+	uint8_t incoming_move;
+};
+
+/**
+ * Data class that stores the calcuation results of one worker thread. The tasks merge their results into the instance
+ * of their thread, so they never write to shared data. The instances are combined after the search.
+ */
+struct OutputData {
+public:
+	uint16_t longestPathLength = 0;
+	uint16_t longestPathCount = 0;
+	Chessboard longestPathBoard;
+	PruningStats reachabilityStats;
+
+	//The number of paths with at least the minimum length, see SearchOptions::minLength
+	uint64_t witnessCount = 0;
 };
 
 #endif /* DATA_H */
@@ -8,6 +8,16 @@
   */
 std::vector<std::pair<uint8_t, uint8_t>> LUKPStartOptimization::getStartingFields(Chessboard& cboard) const{
   std::vector<std::pair<uint8_t, uint8_t>> fields;
+  //In the canonical mode every field is a start field, the cycles are separated by getStartingBoard() instead
+  if(this->options.canonical){
+    for(uint8_t y = 0; y < cboard.getHeight(); ++y){
+      for(uint8_t x = 0; x < cboard.getWidth(); ++x){
+        fields.push_back(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+      }
+    }
+    return fields;
+  }
+
   for(uint8_t x = 0; x <= (cboard.getWidth()  - 1)/2; ++x){
 	  for(uint8_t y = 0; y<= (cboard.getHeight() - 1)/2; ++y){
       //Just take the lower left quadrant, the others can be rotated or mirrored on the horizontal and vertical axis.
@@ -21,6 +31,30 @@ std::vector<std::pair<uint8_t, uint8_t>> LUKPStartOptimization::getStartingField
   return fields;
 }
 
+/**
+  * @brief  Sets the options that select how the start configurations are calculated.
+  * @param  _options The search options
+  * @retval None
+  */
+void LUKPStartOptimization::setSearchOptions(const SearchOptions& _options){
+  this->options = _options;
+}
+
+/**
+  * @brief  Returns a copy of the chessboard to start from the given root. In the canonical mode all fields before the root
+  *         are blocked, so a cycle is only found from its field with the smallest index.
+  * @param  cboard  The empty chessboard
+  * @param  root    The root (start field)
+  * @retval The chessboard to start from
+  */
+Chessboard LUKPStartOptimization::getStartingBoard(Chessboard& cboard, std::pair<uint8_t, uint8_t> root) const{
+  Chessboard start = cboard;
+  if(this->options.canonical){
+    start.blockFieldsBefore(start.toIndex(root));
+  }
+  return start;
+}
+
 /**
   * @brief  Start move optimization: Determins all moves for a given start field that need to be selected as starting moves for the algorithm.
   * This takes symmetries into concideration. For details see chapter 2.1 figure 6.
@@ -39,10 +73,12 @@ uint8_t LUKPStartOptimization::getStartingMoves(Chessboard& cboard, std::pair<ui
     if(cboard.at(target.first, target.second) != 0b11111111) { moves |= move;}
   }
 
-  //Optimize symmetric moves (diagonal, vertical, horizontal)
-  if(width == height && root.first == root.second)	  { moves &= 0b00011110; } //Diagonal axis
-  if((width % 2 == 1) && (root.first == (width/2)))	  { moves &= 0b00001111; } //Vertical axis
-  if((height % 2 == 1) && (root.second == (height/2)))	  { moves &= 0b00111100; } //Horizontal axis
+  //Optimize symmetric moves (diagonal, vertical, horizontal). In the canonical mode every field is a root, so there are no symmetries.
+  if(!this->options.canonical){
+    if(width == height && root.first == root.second)	  { moves &= 0b00011110; } //Diagonal axis
+    if((width % 2 == 1) && (root.first == (width/2)))	  { moves &= 0b00001111; } //Vertical axis
+    if((height % 2 == 1) && (root.second == (height/2)))	  { moves &= 0b00111100; } //Horizontal axis
+  }
 
   for(uint8_t move = 0b00000001; move > 0; move <<= 1) { if((move & moves) != 0) { count++; } }
   if(count < 2) { return moves; }
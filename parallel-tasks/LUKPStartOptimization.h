@@ -5,9 +5,15 @@
 #include <vector>
 
 #include "Chessboard.h"
+#include "SearchOptions.h"
 
 class LUKPStartOptimization {
+private:
+	SearchOptions options;
+
 public:
+	void setSearchOptions(const SearchOptions&);
+	Chessboard getStartingBoard(Chessboard&, std::pair<uint8_t, uint8_t>) const;
 	uint8_t getStartingMoves(Chessboard&, std::pair<uint8_t, uint8_t>) const;
 	std::vector<std::pair<uint8_t, uint8_t>> getStartingFields(Chessboard&) const;
 };
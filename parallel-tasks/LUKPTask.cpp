@@ -1,45 +1,103 @@
 #include "LUKPTask.h"
 
-LUKPTask::LUKPTask(Chessboard &cboard, std::pair<uint8_t, uint8_t> source, uint8_t incoming_move, tbb::atomic<uint16_t>* longestPathLength, tbb::atomic<uint16_t>* longestPathCount, tbb::atomic<OutputData*>* longestPathBoard) 
-  : cboard(cboard), source(source), incoming_move(incoming_move), longestPathLength(longestPathLength), longestPathCount(longestPathCount), longestPathBoard(longestPathBoard){ }
+template<typename Board>
+LUKPTask<Board>::LUKPTask(Board &cboard, uint16_t source, uint8_t incoming_move, const SearchOptions* options, tbb::atomic<uint16_t>* bestLength, tbb::combinable<OutputData>* results, ProgressReporter* progress, bool unit, AnytimeSearch* anytime) 
+  : cboard(cboard), source(source), incoming_move(incoming_move), options(options), bestLength(bestLength), results(results), progress(progress), unit(unit), anytime(anytime){ }
+
+template<typename Board>
+tbb::task* LUKPTask<Board>::execute(){
+  //A task runs on one thread from start to end, even while it waits for its children
+  this->out = &this->results->local();
+  if(this->progress != nullptr){
+    this->threadProgress = &this->progress->local();
+  }
+
+  this->process();
+
+  //The task of a start configuration ends after all tasks of its subtree
+  if(this->unit && this->progress != nullptr){
+    this->progress->finishUnit(0, 0);
+  }
+  if(this->unit && !this->anytime->isExpired()){
+    this->anytime->finishUnit();
+  }
+  return nullptr;
+}
+
+/**
+  * @brief  Processes the node of this task: it is pruned, backtracked sequentially below the cut-off or expanded into child tasks.
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::process(){
+  if(this->threadProgress != nullptr){
+    this->threadProgress->addNode();
+  }
+  if(this->anytime->isExpired()){
+    return;
+  }
+  if(this->options->bound && this->isPrunable(this->source)){
+    return;
+  }
+  if(this->options->reachability > 0 && this->isDisconnected(this->source)){
+    return;
+  }
+
+  //Below the cut-off the subtree is too small to pay off the task overhead, it is backtracked within this task
+  if(this->isBelowCutoff()){
+    this->backtracking(this->source, this->incoming_move);
+    this->mergeResult();
+    return;
+  }
 
-tbb::task* LUKPTask::execute(){
   tbb::task_list children;
   uint8_t child_count = 0;
-  uint16_t currentLongestPathLength = 0, currentLongestPathCount = 0;
-  Chessboard currentLongestPathBoard;
 
-  for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
-    std::pair<uint8_t, uint8_t> target = cboard.doMove(this->source, outgoing_move);
+  //Only the open moves are processed, lowest bit first. A move to the root is open if it doesn't cross an edge.
+  for(uint8_t open = cboard.getOpenMoves(this->source); open != 0; open &= open - 1) {
+    uint8_t outgoing_move = open & -open;
+    uint16_t target = cboard.doMove(this->source, outgoing_move);
 
-    if(cboard.isFinishable(this->source, target, outgoing_move)) {
+    if(this->options->inPlace && target == cboard.getRootIndex() && this->isCanonicalClosing(outgoing_move)) {
+      //The finishing move is set temporarily on the board of this task. Only a new longest path gets copied.
+      this->storeCycle(this->source, this->incoming_move, outgoing_move);
+    } else if(target == cboard.getRootIndex() && this->isCanonicalClosing(outgoing_move)) {
       uint8_t moves = outgoing_move | cboard.rotate180(this->incoming_move);
 
-      Chessboard cpy = this->cboard;
-      std::pair<uint8_t, uint8_t> root = cpy.getRoot();
+      Board cpy = this->cboard;
+      uint16_t root = cpy.getRootIndex();
 
       cpy.setField(moves, this->source);
-      cpy.updateField((cpy.at(root.first, root.second) | cboard.rotate180(outgoing_move)), root);
+      cpy.updateField((cpy.at(root) | cboard.rotate180(outgoing_move)), root);
 
       if(cpy.getLength() == currentLongestPathLength){
-        this->longestPathCount++;
+        currentLongestPathCount++;
       }
       else if(cpy.getLength() > currentLongestPathLength){
         currentLongestPathLength = cpy.getLength();
         currentLongestPathCount = 1; 
         currentLongestPathBoard = cpy;
+        this->publishLength(currentLongestPathLength);
+        this->offerPath();
       }
-    } else if(!cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(this->source, outgoing_move)) {
+      this->checkWitness(cpy.getLength());
+    } else if(target != cboard.getRootIndex()) {
       uint8_t moves = outgoing_move | cboard.rotate180(this->incoming_move);
+      LUKPTask<Board>* child;
 
-      Chessboard cpy = this->cboard;
-      cpy.setField(moves, this->source);
-
-      LUKPTask* child = new (tbb::task::allocate_child()) LUKPTask(cpy, target, outgoing_move, this->longestPathCount, this->longestPathLength, this->longestPathBoard);
+      if(this->options->inPlace){
+        //The move is only set while the child copies the board of this task, which saves the intermediate copy
+        cboard.setField(moves, this->source);
+        child = new (tbb::task::allocate_child()) LUKPTask<Board>(cboard, target, outgoing_move, this->options, this->bestLength, this->results, this->progress, false, this->anytime);
+        cboard.unsetField(this->source);
+      }else{
+        Board cpy = this->cboard;
+        cpy.setField(moves, this->source);
+        child = new (tbb::task::allocate_child()) LUKPTask<Board>(cpy, target, outgoing_move, this->options, this->bestLength, this->results, this->progress, false, this->anytime);
+      }
       children.push_back(*child);
       child_count++;
     }
-    //else { Field is used or crosses path -> do nothing}
   }
 
   //Start child tasks and block
@@ -48,15 +106,234 @@ tbb::task* LUKPTask::execute(){
     tbb::task::spawn_and_wait_for_all(children);
   }
 
-  //Check if the completed path is of an important length
-  if(currentLongestPathLength == *this->longestPathLength){
-    *this->longestPathCount += currentLongestPathCount;
+  this->mergeResult();
+}
+
+/**
+  * @brief  Checks whether the node of this task is below the cut-off. Below it no child tasks are spawned.
+  * @retval true:   The path is at least as long as the cut-off depth or not more fields than the cut-off are free
+  *         false:  Child tasks are spawned for the next moves
+  */
+template<typename Board>
+bool LUKPTask<Board>::isBelowCutoff(){
+  uint16_t length = cboard.getLength();
+  if(this->options->cutoffDepth > 0 && length >= this->options->cutoffDepth){
+    return true;
   }
-  if(currentLongestPathLength > *this->longestPathLength){
-    *this->longestPathLength = currentLongestPathLength;
-    *this->longestPathCount = 1;
-    (*this->longestPathBoard)->cboard = currentLongestPathBoard;
+
+  uint16_t free = cboard.getWidth() * cboard.getHeight() - length;
+  return this->options->cutoffFree > 0 && free <= this->options->cutoffFree;
+}
+
+/**
+  * @brief  Sequential in-place backtracking on the board of this task, it is used below the cut-off.
+  *         The found cycles are stored as result of this task.
+  * @param  source        The current field of the path, it isn't set on the board yet
+  * @param  incoming_move The move that lead to the source field
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::backtracking(uint16_t source, uint8_t incoming_move){
+  if(this->threadProgress != nullptr){
+    this->threadProgress->addNode();
+  }
+  if(this->anytime->isExpired()){
+    return;
   }
+  uint8_t incoming = cboard.rotate180(incoming_move);
 
-  return nullptr;
+  //Only the open moves are processed, lowest bit first. A move to the root is open if it doesn't cross an edge.
+  for(uint8_t open = cboard.getOpenMoves(source); open != 0; open &= open - 1) {
+    uint8_t outgoing_move = open & -open;
+    uint16_t target = cboard.doMove(source, outgoing_move);
+
+    if(target == cboard.getRootIndex()) {
+      if(this->isCanonicalClosing(outgoing_move)) { this->storeCycle(source, incoming_move, outgoing_move); }
+    } else {
+      cboard.setField(outgoing_move | incoming, source);
+      if(!(this->options->bound && this->isPrunable(target)) && !(this->options->reachability > 0 && this->isDisconnected(target))){
+        this->backtracking(target, outgoing_move);
+      }
+      cboard.unsetField(source);
+    }
+  }
 }
+
+/**
+  * @brief  Closes the cycle temporarily on the board of this task and stores it, if it is at least as long as the
+  *         longest cycle of this task. Only a new longest cycle gets copied.
+  * @param  source        The current field of the path
+  * @param  incoming_move The move that lead to the source field
+  * @param  outgoing_move The move from the source field back to the root
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::storeCycle(uint16_t source, uint8_t incoming_move, uint8_t outgoing_move){
+  uint8_t moves = outgoing_move | cboard.rotate180(incoming_move);
+  uint16_t root = cboard.getRootIndex();
+  uint8_t rootMoves = cboard.at(root);
+
+  cboard.setField(moves, source);
+  cboard.updateField(rootMoves | cboard.rotate180(outgoing_move), root);
+
+  if(cboard.getLength() == currentLongestPathLength){
+    currentLongestPathCount++;
+  }
+  else if(cboard.getLength() > currentLongestPathLength){
+    currentLongestPathLength = cboard.getLength();
+    currentLongestPathCount = 1;
+    currentLongestPathBoard = cboard;
+    this->publishLength(currentLongestPathLength);
+    this->offerPath();
+  }
+  this->checkWitness(cboard.getLength());
+
+  cboard.updateField(rootMoves, root);
+  cboard.unsetField(source);
+}
+
+/**
+  * @brief  Merges the longest cycles of this task and its children into the result of the current thread.
+  *         The result isn't shared with other threads, so no synchronization is needed.
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::mergeResult(){
+  if(currentLongestPathLength == this->out->longestPathLength){
+    this->out->longestPathCount += currentLongestPathCount;
+  }
+  else if(currentLongestPathLength > this->out->longestPathLength){
+    this->out->longestPathLength = currentLongestPathLength;
+    this->out->longestPathCount = currentLongestPathCount;
+    this->out->longestPathBoard = static_cast<Chessboard>(currentLongestPathBoard);
+  }
+  if(this->progress != nullptr && currentLongestPathCount > 0){
+    this->progress->mergeLongest(currentLongestPathLength, currentLongestPathCount);
+  }
+}
+
+/**
+  * @brief  The length that a path needs to reach to be searched further: the longest path length of all tasks,
+  *         or the next longer length if the paths aren't counted. With a minimum length it is the minimum length instead.
+  * @param  None
+  * @retval The length limit of the branch and bound
+  */
+template<typename Board>
+uint16_t LUKPTask<Board>::getBoundLimit() const{
+  uint16_t best = *this->bestLength;
+  uint16_t limit = this->options->countPaths ? best : best + 1;
+  if(this->options->minLength > 0){
+    limit = this->options->minLength;
+  }
+  //A closed path alternates between the two field colors, so its length is even
+  return limit + (limit & 1);
+}
+
+/**
+  * @brief  Checks whether the subtree of this task can be pruned. The path can at most be extended by the free fields
+  *         that are reachable from source over open moves, so the current length plus their number is an upper bound
+  *         for its length. If the root can't be reached anymore, the path can't be closed at all, see Chessboard::countReachable().
+  *         The bound is the longest path length of all tasks, with a minimum length it is the minimum length instead.
+  *         The check runs every BOUND_INTERVAL plies.
+  * @param  source The current field of the path
+  * @retval true:   The subtree can't beat the longest path (or reach its length, if the paths are counted)
+  *         false:  The subtree needs to be processed
+  */
+template<typename Board>
+bool LUKPTask<Board>::isPrunable(uint16_t source){
+  uint16_t limit = this->getBoundLimit();
+  if(cboard.getLength() % BOUND_INTERVAL != 0 || cboard.getLength() + 1 >= limit){
+    return false;
+  }
+
+  uint16_t needed = limit - cboard.getLength();
+  return cboard.countReachable(source, needed) < needed;
+}
+
+/**
+  * @brief  Checks every k plies whether the path of this task can still return to the root. If it can't, the subtree is cut.
+  *         The counters are stored per thread, so the tasks don't share a counter.
+  *         If the bound of -p was checked on this ply, it already covers the root, so it isn't searched twice.
+  * @param  source The current field of the path
+  * @retval true:   The root can't be reached anymore, the subtree can be pruned
+  *         false:  The subtree needs to be processed
+  */
+template<typename Board>
+bool LUKPTask<Board>::isDisconnected(uint16_t source){
+  if(cboard.getLength() % this->options->reachability != 0){
+    return false;
+  }
+  if(this->options->bound && cboard.getLength() % BOUND_INTERVAL == 0 && cboard.getLength() + 1 < this->getBoundLimit()){
+    return false;
+  }
+
+  bool disconnected = !cboard.isRootReachable(source);
+  this->out->reachabilityStats.checked++;
+  this->out->reachabilityStats.pruned += disconnected;
+  return disconnected;
+}
+
+/**
+  * @brief  In the canonical mode each cycle is only accepted in one direction: the move that closes the cycle
+  *         needs to be a larger move of the root than the first move. Otherwise every closing move is accepted.
+  * @param  outgoing_move The move that closes the cycle
+  * @retval true:   The cycle is accepted
+  *         false:  The cycle is found in the other direction
+  */
+template<typename Board>
+bool LUKPTask<Board>::isCanonicalClosing(uint8_t outgoing_move){
+  return !this->options->canonical || cboard.rotate180(outgoing_move) > cboard.at(cboard.getRootIndex());
+}
+
+/**
+  * @brief  Writes the longest cycle of this task to the file of the longest path so far, if the search has a deadline.
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::offerPath(){
+  if(this->options->deadline > 0){
+    this->anytime->offerPath(static_cast<Chessboard>(currentLongestPathBoard));
+  }
+}
+
+/**
+  * @brief  Counts a cycle in the result of the current thread if it has at least the minimum length.
+  *         Without counting the witnesses, the first one stops all tasks. Every cycle of this task before it is shorter,
+  *         so the witness is the longest cycle of this task and is merged as usual.
+  * @param  length The length of the cycle
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::checkWitness(uint16_t length){
+  if(this->options->minLength == 0 || length < this->options->minLength){
+    return;
+  }
+  this->out->witnessCount++;
+  if(!this->options->countWitnesses){
+    this->anytime->stopEarly();
+  }
+}
+
+/**
+  * @brief  Publishes a new longest path length to all tasks, so they can prune with it immediately.
+  *         The shared length is only increased.
+  * @param  length The length of the path that was found
+  * @retval None
+  */
+template<typename Board>
+void LUKPTask<Board>::publishLength(uint16_t length){
+  uint16_t seen = *this->bestLength;
+  while(length > seen){
+    uint16_t previous = this->bestLength->compare_and_swap(length, seen);
+    if(previous == seen) break;
+    seen = previous;
+  }
+}
+
+template class LUKPTask<Chessboard>;
+template class LUKPTask<Bitboard>;
+
+//Explicit instantiations of the specialised kernels
+#define INSTANTIATE_SPECIALISED(W, H) template class LUKPTask<FixedChessboard<W, H>>;
+FIXED_CHESSBOARD_SIZES(INSTANTIATE_SPECIALISED)
+#undef INSTANTIATE_SPECIALISED
@@ -8,21 +8,61 @@
 #include "tbb/task.h"
 #include <tbb/tbb.h>
 #include <tbb/atomic.h>
+#include <tbb/combinable.h>
 
 #include "LongestUncrossedKnightsPath.h"
+#include "Bitboard.h"
+#include "FixedChessboard.h"
+#include "SearchOptions.h"
+#include "PruningStats.h"
+#include "ProgressReporter.h"
+#include "AnytimeSearch.h"
 
+/**
+ * A task that processes one node of the backtracking. The board type is the Chessboard, the Bitboard or a FixedChessboard.
+ */
+template<typename Board>
 class LUKPTask: public tbb::task {
-	Chessboard cboard;
-	std::pair<uint8_t, uint8_t> source;
+	Board cboard;
+	uint16_t source;
 	uint8_t incoming_move;
+	const SearchOptions* options;
 
-	//Atomic varialbes to share data storage between tasks
-	tbb::atomic<uint16_t>* longestPathLength;
-	tbb::atomic<uint16_t>* longestPathCount;
-	tbb::atomic<OutputData*>* longestPathBoard;
+	//The longest path length found by any task so far, used as bound for the pruning
+	tbb::atomic<uint16_t>* bestLength;
+
+	//The results and counters of the reachability pruning, one instance per thread
+	tbb::combinable<OutputData>* results;
+	OutputData* out = nullptr;
+
+	//Only set with the progress: the reporter, the node counter of the current thread and whether this task is a start configuration
+	ProgressReporter* progress;
+	ThreadProgress* threadProgress = nullptr;
+	bool unit;
+
+	//The deadline of the search, the tasks return as soon as it is expired
+	AnytimeSearch* anytime;
+
+	//The longest cycles of this task and its children
+	uint16_t currentLongestPathLength = 0;
+	uint16_t currentLongestPathCount = 0;
+	Board currentLongestPathBoard;
+
+	void process();
+	bool isBelowCutoff();
+	void backtracking(uint16_t, uint8_t);
+	void storeCycle(uint16_t, uint8_t, uint8_t);
+	void mergeResult();
+	uint16_t getBoundLimit() const;
+	bool isPrunable(uint16_t);
+	bool isDisconnected(uint16_t);
+	bool isCanonicalClosing(uint8_t);
+	void publishLength(uint16_t);
+	void offerPath();
+	void checkWitness(uint16_t);
 public:
 	
-	LUKPTask(Chessboard&, std::pair<uint8_t, uint8_t>, uint8_t, tbb::atomic<uint16_t>*, tbb::atomic<uint16_t>*, tbb::atomic<OutputData*>*);
+	LUKPTask(Board&, uint16_t, uint8_t, const SearchOptions*, tbb::atomic<uint16_t>*, tbb::combinable<OutputData>*, ProgressReporter*, bool, AnytimeSearch*);
 	tbb::task* execute();
 };
 
@@ -18,6 +18,15 @@ void LongestUncrossedKnightsPath::limitThreads(uint8_t threads){
 	this->n_threads = threads;
 }
 
+/**
+  * @brief  Sets the options that select how the backtracking is executed.
+  * @param  _options The search options
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::setSearchOptions(const SearchOptions& _options){
+	this->options = _options;
+}
+
 /**
   * @brief  Runs the algorithm for all starting fields.
   * It takes the optimization from the LUKPStartOptimization and stores them as start configuration to calculate the paths.
@@ -26,11 +35,13 @@ void LongestUncrossedKnightsPath::limitThreads(uint8_t threads){
   */
 void LongestUncrossedKnightsPath::run() {
   LUKPStartOptimization startOptimization;
+  startOptimization.setSearchOptions(this->options);
 
 	std::vector<InputData> input;
 	std::vector<std::pair<uint8_t, uint8_t>> fields = startOptimization.getStartingFields(this->chessboard);
 	for(int i=0; i<fields.size(); i++){
-		uint8_t moves = startOptimization.getStartingMoves(this->chessboard, fields[i]);
+		Chessboard start = startOptimization.getStartingBoard(this->chessboard, fields[i]);
+		uint8_t moves = startOptimization.getStartingMoves(start, fields[i]);
 		for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
 			InputData in;
 
@@ -58,29 +69,251 @@ void LongestUncrossedKnightsPath::runInternal(std::vector<InputData>& input){
 		std::cout << "Limiting number of threads to " << (int) n_threads << "." << std::endl;
 	}
 	tbb::task_scheduler_init init(n_threads > 0 ? n_threads : tbb::task_scheduler_init::automatic);
+	if(this->options.calibrate){
+		this->options.cutoffDepth = this->calibrateCutoff(input);
+	}
+
+	//The bound for the pruning, every task publishes its longest paths immediately
+	//A known lower bound is taken as longest length, without counting a path of this length still needs to be found once
+	tbb::atomic<uint16_t> bestLength = 0;
+	if(this->options.lowerBound > 0){
+		bestLength = this->options.countPaths ? this->options.lowerBound : this->options.lowerBound - 1;
+	}
+
+	//The results are collected per thread and combined after the search
+	tbb::combinable<OutputData> results;
+
+	//Each start configuration is a work unit of the progress
+	ProgressReporter progress;
+	if(this->options.progressInterval > 0){
+		progress.start(this->options.progressInterval, input.size(), 0);
+	}
+	AnytimeSearch anytime;
+	if(this->options.deadline > 0){
+		anytime.start(this->options.deadline);
+	}
+	anytime.addUnits(input.size());
+
+	this->runTasks(input, &bestLength, &results, this->options.progressInterval > 0 ? &progress : nullptr, &anytime);
+	progress.stop();
+	anytime.stop();
+
+	OutputData result;
+	results.combine_each([&result](const OutputData& out) {
+		result.reachabilityStats += out.reachabilityStats;
+		result.witnessCount += out.witnessCount;
+		if(out.longestPathLength == result.longestPathLength){
+			result.longestPathCount += out.longestPathCount;
+		}else if(out.longestPathLength > result.longestPathLength){
+			result.longestPathLength = out.longestPathLength;
+			result.longestPathCount = out.longestPathCount;
+			result.longestPathBoard = out.longestPathBoard;
+		}
+	});
+
+	anytime.report();
+	//With a minimum length only a witness is exported, a shorter path doesn't answer the question
+	FileExporter fileExporter;
+	if(result.longestPathLength > 0 && (this->options.minLength == 0 || result.witnessCount > 0)){
+		fileExporter.exportPath(result.longestPathBoard, 1);
+	}
 
-	//The atomic variables that contain the longest path stats
-	tbb::atomic<uint16_t> longestPathLength = 0;   
-  	tbb::atomic<uint16_t> longestPathCount = 0;
-	tbb::atomic<OutputData*> longestPathBoard = new OutputData();
-	
-	//Iterate over all start configurations
+	if(this->options.reachability > 0){
+		std::cout << "Reachability pruning cut " << result.reachabilityStats.pruned << " of " << result.reachabilityStats.checked << " checked nodes." << std::endl;
+	}
+	if(this->options.minLength > 0){
+		this->reportWitness(result, anytime);
+	}else if(this->options.countPaths){
+		std::cout << "Longest path is " << (int) result.longestPathLength << " with " << (int) result.longestPathCount << " equal length occurrences." << std::endl;
+	}else{
+		std::cout << "Longest path is " << (int) result.longestPathLength << "." << std::endl;
+	}
+}
+
+/**
+  * @brief  Spawns the tasks of all start configurations and waits until they are finished.
+  *         All start configurations are children of one empty root task, so the scheduler can balance the work across all of them at once.
+  * @param  input             The start configurations
+  * @param  bestLength        The shared bound for the pruning
+  * @param  results           The results of the threads
+  * @param  progress          The reporter of the progress, nullptr without it
+  * @param  anytime           The deadline of the search
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::runTasks(std::vector<InputData>& input, tbb::atomic<uint16_t>* bestLength, tbb::combinable<OutputData>* results, ProgressReporter* progress, AnytimeSearch* anytime){
+	tbb::empty_task* root = new (tbb::task::allocate_root()) tbb::empty_task;
+	tbb::task_list children;
 	for(int i=0; i<input.size(); i++){
-		std::pair<uint8_t, uint8_t> field = input[i].field;
 		uint8_t move = input[i].move;
+		Chessboard cboard = this->setupBoard(input[i]);
+		children.push_back(*this->createStartTask(*root, cboard, move, bestLength, results, progress, anytime));
+	}
 
-		//Create the setup
-		Chessboard cboard = chessboard;
-		cboard.setRoot(move, field);
-		std::pair<uint8_t, uint8_t> target = cboard.doMove(field, move);
-		
-		//Start the root task for the start optimization
-		LUKPTask* root = new (tbb::task::allocate_root()) LUKPTask(cboard, target, move, &longestPathLength, &longestPathCount, &longestPathBoard);
-		tbb::task::spawn_root_and_wait(*root);
+	root->set_ref_count((int)input.size() + 1);
+	root->spawn_and_wait_for_all(children);
+	tbb::task::destroy(*root);
+}
+
+/**
+  * @brief  Creates the chessboard of a start configuration with the root set.
+  *         In the canonical mode the fields before the root are blocked, see LUKPStartOptimization::getStartingBoard().
+  * @param  in	The start configuration
+  * @retval The chessboard of the start configuration
+  */
+Chessboard LongestUncrossedKnightsPath::setupBoard(const InputData& in){
+	Chessboard cboard = chessboard;
+	if(this->options.canonical){
+		cboard.blockFieldsBefore(cboard.toIndex(in.field));
 	}
+	cboard.setRoot(in.move, in.field);
+	return cboard;
+}
 
-	FileExporter fileExporter;
-	fileExporter.exportPath(longestPathBoard->cboard, 1);
+/**
+  * @brief  Calibrates the cut-off depth with a short probe run on this machine. First the probe expands the paths of all start
+  *         configurations level by level without spawning tasks, until a path length has enough subtrees to keep all threads busy.
+  *         This is the smallest candidate. Deeper cut-offs balance the work better, but pay the task overhead more often.
+  *         How much that costs depends on the machine, so each candidate is timed with the actual search for CALIBRATION_SECONDS
+  *         and the one that visits the most nodes per second is taken.
+  * @param  input	The start configurations
+  * @retval The calibrated cut-off depth
+  */
+uint16_t LongestUncrossedKnightsPath::calibrateCutoff(std::vector<InputData>& input){
+	auto start = std::chrono::system_clock::now();
+	int threads = n_threads > 0 ? n_threads : tbb::task_scheduler_init::default_num_threads();
 
-  	std::cout << "Longest path is " << (int) longestPathLength << " with " << (int) longestPathCount << " equal length occurrences." << std::endl;
+	//All start configurations are processed at once, so their subtrees together need to keep the threads busy
+	size_t goal = (size_t) CALIBRATION_SUBTREES_PER_THREAD * threads;
+
+	std::vector<ProbeNode> level;
+	for(int i=0; i<input.size(); i++){
+		ProbeNode node;
+		node.cboard = this->setupBoard(input[i]);
+		node.source = node.cboard.doMove(node.cboard.getRootIndex(), input[i].move);
+		node.incoming_move = input[i].move;
+		level.push_back(node);
+	}
+
+	uint16_t depth = level.empty() ? 0 : level[0].cboard.getLength();
+	while(!level.empty() && level.size() < goal){
+		std::vector<ProbeNode> next;
+		for(ProbeNode& node : level){
+			for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
+				uint16_t target = node.cboard.doMove(node.source, outgoing_move);
+				if(node.cboard.isFieldReserved(target) || node.cboard.isConnectionCrossesEdge(node.source, outgoing_move)) continue;
+
+				ProbeNode child = node;
+				child.cboard.setField(outgoing_move | node.cboard.rotate180(node.incoming_move), node.source);
+				child.source = target;
+				child.incoming_move = outgoing_move;
+				next.push_back(child);
+			}
+		}
+		level.swap(next);
+		depth++;
+	}
+	std::cout << "At least " << (int) depth << " plies give " << level.size() << " subtrees for " << threads << " threads." << std::endl;
+
+	//The probes neither write the best path nor print the progress, the cut-off by free fields would hide the candidates
+	SearchOptions options = this->options;
+	this->options.deadline = 0;
+	this->options.progressInterval = 0;
+	this->options.cutoffFree = 0;
+
+	uint16_t fastest = depth;
+	double fastestRate = -1;
+	for(uint16_t candidate = depth; candidate < depth + CALIBRATION_CANDIDATES; candidate++){
+		this->options.cutoffDepth = candidate;
+		double rate = this->probeCutoff(input);
+		std::cout << "Cut-off depth " << (int) candidate << ": " << (uint64_t) rate << " nodes/s" << std::endl;
+		if(rate > fastestRate){
+			fastestRate = rate;
+			fastest = candidate;
+		}
+	}
+	this->options = options;
+
+	std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+	std::cout << "Calibrated the cut-off depth to " << (int) fastest << " in " << elapsed_seconds.count() << " seconds." << std::endl;
+	return fastest;
+}
+
+/**
+  * @brief  Runs the search with the current options for at most CALIBRATION_SECONDS and measures its speed.
+  *         The probe starts from scratch, so its paths and its bound don't influence the actual search.
+  * @param  input	The start configurations
+  * @retval The visited nodes per second
+  */
+double LongestUncrossedKnightsPath::probeCutoff(std::vector<InputData>& input){
+	tbb::atomic<uint16_t> bestLength = 0;
+	tbb::combinable<OutputData> results;
+	ProgressReporter progress;
+	AnytimeSearch anytime;
+
+	auto start = std::chrono::steady_clock::now();
+	anytime.start(CALIBRATION_SECONDS);
+	this->runTasks(input, &bestLength, &results, &progress, &anytime);
+	anytime.stop();
+	std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+	return progress.countNodes() / elapsed_seconds.count();
+}
+
+/**
+  * @brief  Creates the task of a start configuration as child of the root task. Board sizes with a specialised kernel are
+  *         processed as FixedChessboard, other boards with at most 64 fields are processed as bitboard.
+  * @param  root              The root task of all start configurations
+  * @param  cboard            The chessboard of the start configuration with the root set
+  * @param  move              The first move from the root
+  * @param  bestLength        The shared bound for the pruning
+  * @param  results           The results of the threads
+  * @param  progress          The reporter of the progress, nullptr without it
+  * @param  anytime           The deadline of the search
+  * @retval The task of the start configuration, it isn't spawned yet
+  */
+tbb::task* LongestUncrossedKnightsPath::createStartTask(tbb::task& root, Chessboard& cboard, uint8_t move, tbb::atomic<uint16_t>* bestLength, tbb::combinable<OutputData>* results, ProgressReporter* progress, AnytimeSearch* anytime){
+	if(this->options.specialised){
+		switch(FIXED_CHESSBOARD_KEY(cboard.getWidth(), cboard.getHeight())){
+#define CREATE_SPECIALISED(W, H) \
+			case FIXED_CHESSBOARD_KEY(W, H): { \
+				FixedChessboard<W, H> fboard(cboard); \
+				uint16_t target = fboard.doMove(fboard.getRootIndex(), move); \
+				return new (root.allocate_child()) LUKPTask<FixedChessboard<W, H>>(fboard, target, move, &this->options, bestLength, results, progress, true, anytime); \
+			}
+			FIXED_CHESSBOARD_SIZES(CREATE_SPECIALISED)
+#undef CREATE_SPECIALISED
+			default:
+				break;
+		}
+	}
+
+	if(this->options.bitboard && Bitboard::fits(cboard.getWidth(), cboard.getHeight())){
+		Bitboard bboard(cboard);
+		uint16_t target = bboard.doMove(bboard.getRootIndex(), move);
+		return new (root.allocate_child()) LUKPTask<Bitboard>(bboard, target, move, &this->options, bestLength, results, progress, true, anytime);
+	}
+
+	uint16_t target = cboard.doMove(cboard.getRootIndex(), move);
+	return new (root.allocate_child()) LUKPTask<Chessboard>(cboard, target, move, &this->options, bestLength, results, progress, true, anytime);
+}
+
+/**
+  * @brief  Prints whether a path with at least the minimum length exists, or how many there are with --count-witnesses.
+  * @param  result	The combined results of the threads
+  * @param  anytime	The deadline of the search, a search stopped by it didn't prove that there is no witness
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::reportWitness(const OutputData& result, const AnytimeSearch& anytime){
+	uint16_t minLength = this->options.minLength;
+	if(result.witnessCount == 0){
+		if(anytime.isExpired()){
+			std::cout << "No path with at least " << minLength << " fields was found." << std::endl;
+		}else{
+			std::cout << "There is no path with at least " << minLength << " fields." << std::endl;
+		}
+	}else if(this->options.countWitnesses){
+		std::cout << "There are " << result.witnessCount << " paths with at least " << minLength << " fields, the longest has " << (int) result.longestPathLength << " fields." << std::endl;
+	}else{
+		std::cout << "A path with at least " << minLength << " fields exists, it has " << (int) result.longestPathLength << " fields." << std::endl;
+	}
 }
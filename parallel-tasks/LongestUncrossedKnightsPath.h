@@ -3,17 +3,31 @@
 
 #include <iostream>
 #include <stdint.h>
+#include <chrono>
+#include <vector>
 
 #include "tbb/parallel_for.h"
 #include "tbb/blocked_range.h"
 #include "tbb/partitioner.h"
 #include "tbb/task_scheduler_init.h"
+#include "tbb/combinable.h"
 
 #include "Chessboard.h"
 #include "LUKPData.h"
 #include "LUKPStartOptimization.h"
 #include "LUKPTask.h"
 #include "FileExporter.h"
+#include "SearchOptions.h"
+#include "PruningStats.h"
+#include "ProgressReporter.h"
+#include "AnytimeSearch.h"
+
+//The calibrated cut-off leaves at least this many sequential subtrees per thread
+#define CALIBRATION_SUBTREES_PER_THREAD 16
+//The number of cut-off depths that are timed, starting with the smallest one that has enough subtrees
+#define CALIBRATION_CANDIDATES 4
+//The time of the probe run of each candidate
+#define CALIBRATION_SECONDS 1
 
 class LongestUncrossedKnightsPath {
  
@@ -21,14 +35,22 @@ private:
 	uint8_t n_threads = 0;
 
 	Chessboard chessboard;
+	SearchOptions options;
 
 	void runInternal(std::vector<InputData>&);
+	void runTasks(std::vector<InputData>&, tbb::atomic<uint16_t>*, tbb::combinable<OutputData>*, ProgressReporter*, AnytimeSearch*);
+	Chessboard setupBoard(const InputData&);
+	uint16_t calibrateCutoff(std::vector<InputData>&);
+	double probeCutoff(std::vector<InputData>&);
+	tbb::task* createStartTask(tbb::task&, Chessboard&, uint8_t, tbb::atomic<uint16_t>*, tbb::combinable<OutputData>*, ProgressReporter*, AnytimeSearch*);
+	void reportWitness(const OutputData&, const AnytimeSearch&);
 
 public:
 	LongestUncrossedKnightsPath(uint8_t, uint8_t);
 	virtual ~LongestUncrossedKnightsPath();
 
 	void limitThreads(uint8_t);
+	void setSearchOptions(const SearchOptions&);
 	void run();
 };
 
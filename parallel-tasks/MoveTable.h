@@ -0,0 +1,117 @@
+#ifndef MOVETABLE_H
+#define MOVETABLE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define MOVE_COUNT 8
+#define NEIGHBOUR_COUNT 4
+#define CROSSING_COUNT 9
+
+/**
+ * Precomputed move data for a board width. A move in the bit format 1 << i has the index i.
+ * For each move it contains the field offset of the target and the four neighbours that need to be checked
+ * for a crossing, together with the moves of these neighbours that would cross the move (see figure 5).
+ * The offsets are flat index deltas for a row length of totalWidth. The tables are shared by all boards of the same width.
+ * The crossing tables are the inverse of the neighbour tables, the boards use them to update the crossed moves of the fields
+ * around an edge when it is set or removed.
+ */
+class MoveTable {
+public:
+	//Position deltas of the target and of the relevant neighbours of each move
+	static constexpr int8_t moveDx[MOVE_COUNT] = { 1,  2,  2,  1, -1, -2, -2, -1};
+	static constexpr int8_t moveDy[MOVE_COUNT] = { 2,  1, -1, -2, -2, -1,  1,  2};
+
+	//The colors refer to the cases in figure 5: orange, blue, green, purple
+	static constexpr int8_t neighbourDx[MOVE_COUNT][NEIGHBOUR_COUNT] = {
+		{ 0,  1,  1,  0},
+		{ 1,  1,  0,  2},
+		{ 1,  1,  0,  2},
+		{ 1,  0,  1,  0},
+		{ 0, -1, -1,  0},
+		{-1, -1,  0, -2},
+		{-1, -1,  0, -2},
+		{-1,  0, -1,  0}
+	};
+	static constexpr int8_t neighbourDy[MOVE_COUNT][NEIGHBOUR_COUNT] = {
+		{ 1,  1,  0,  2},
+		{ 1,  0,  1,  0},
+		{ 0, -1, -1,  0},
+		{-1, -1,  0, -2},
+		{-1, -1,  0, -2},
+		{-1,  0, -1,  0},
+		{ 0,  1,  1,  0},
+		{ 1,  1,  0,  2}
+	};
+
+	//The moves of a neighbour that cross the move
+	static constexpr uint8_t neighbourMask[MOVE_COUNT][NEIGHBOUR_COUNT] = {
+		{0b00001110, 0b11100000, 0b01000000, 0b00001100},
+		{0b00011100, 0b11000001, 0b00001000, 0b11000000},
+		{0b00111000, 0b10000011, 0b00000001, 0b00110000},
+		{0b01110000, 0b00000111, 0b00100000, 0b00000011},
+		{0b11100000, 0b00001110, 0b00000100, 0b11000000},
+		{0b11000001, 0b00011100, 0b10000000, 0b00001100},
+		{0b10000011, 0b00111000, 0b00010000, 0b00000011},
+		{0b00000111, 0b01110000, 0b00000010, 0b00110000}
+	};
+
+	//For each move of a field: the moves of other fields that it crosses and the positions of these fields relative to it.
+	//Every move of a neighbour in neighbourMask is one entry, each move crosses exactly CROSSING_COUNT moves.
+	static constexpr uint8_t crossingMove[MOVE_COUNT][CROSSING_COUNT] = {
+		{ 1,  2,  2,  3,  3,  5,  6,  6,  7},
+		{ 0,  2,  3,  3,  4,  6,  6,  7,  7},
+		{ 0,  0,  1,  3,  4,  4,  5,  5,  7},
+		{ 0,  0,  1,  1,  2,  4,  5,  5,  6},
+		{ 1,  2,  2,  3,  5,  6,  6,  7,  7},
+		{ 0,  2,  2,  3,  3,  4,  6,  7,  7},
+		{ 0,  0,  1,  1,  3,  4,  4,  5,  7},
+		{ 0,  1,  1,  2,  4,  4,  5,  5,  6}
+	};
+	static constexpr int8_t crossingDx[MOVE_COUNT][CROSSING_COUNT] = {
+		{-1, -1,  0,  0,  0,  1,  1,  2,  1},
+		{ 0, -1,  0,  0,  1,  1,  2,  1,  1},
+		{ 0,  0, -1,  0,  1,  1,  1,  2,  1},
+		{ 0,  0, -1,  0, -1,  1,  1,  2,  1},
+		{-1, -1, -2, -1,  1,  1,  0,  0,  0},
+		{-1, -1, -2, -1, -1,  0,  1,  0,  0},
+		{-1, -1, -1, -2, -1,  0,  0,  1,  0},
+		{-1, -1, -2, -1,  0,  0,  1,  0,  1}
+	};
+	static constexpr int8_t crossingDy[MOVE_COUNT][CROSSING_COUNT] = {
+		{ 0,  1,  1,  1,  2,  1,  0,  0, -1},
+		{-1,  1,  1,  2,  1,  0,  0, -1,  0},
+		{-1, -2, -1,  1,  1,  0,  0,  0, -1},
+		{-1, -2, -1, -1,  0,  1,  0,  0, -1},
+		{-1,  0,  0,  1,  0, -1, -1, -1, -2},
+		{-1,  0,  0,  1,  0,  1, -1, -1, -2},
+		{-1,  0,  0,  0,  1,  1,  2,  1, -1},
+		{-1,  0,  0,  1,  1,  2,  1,  1,  0}
+	};
+
+	//Flat index deltas for the row length of this table
+	int16_t moveOffset[MOVE_COUNT];
+	int16_t crossingOffset[MOVE_COUNT][CROSSING_COUNT];
+
+	static const MoveTable* forWidth(uint16_t);
+	static inline uint8_t index(uint8_t move) { return __builtin_ctz(move); }
+	static inline uint8_t crossedMoves(const uint8_t*);
+
+private:
+	explicit MoveTable(uint16_t);
+};
+
+/**
+  * @brief  Returns the moves of a field whose crossing count is not zero. The MOVE_COUNT counts are read as one word,
+  *         the high bit of each byte is set if the byte isn't zero and the high bits are then gathered into one byte.
+  * @param  counts The crossing counts of the moves of a field
+  * @retval The crossed moves in the bit format
+  */
+inline uint8_t MoveTable::crossedMoves(const uint8_t* counts) {
+	uint64_t word;
+	memcpy(&word, counts, sizeof(word));
+	uint64_t nonzero = (((word & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | word) & 0x8080808080808080ULL;
+	return ((nonzero >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+#endif /* MOVETABLE_H */
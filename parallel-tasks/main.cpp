@@ -7,17 +7,16 @@
 
 #include "LongestUncrossedKnightsPath.h"
 
-void get_args(int, char*[], uint8_t&, uint8_t&, uint8_t&);
+bool get_args(int, char*[], uint8_t&, uint8_t&, uint8_t&, SearchOptions&);
 
 void err_abort (const char*);
 
 int main(int argc, char* argv[]) {
     
     uint8_t m = 0, n = 0, t = 0;
-    if(argc == (4+1) || argc == (6+1)){
-        get_args(argc, argv, m, n, t);        
-    }else{
-        err_abort("Valid are: \nWith all startfields: -m 4 -n 4\nWith thread limit -m 4 -n 4 -t 1");
+    SearchOptions options;
+    if(!get_args(argc, argv, m, n, t, options)){
+        err_abort("Valid are: \nWith all startfields: -m 4 -n 4\nWith thread limit -m 4 -n 4 -t 1\nOptional: -c (copy the board for every move instead of in-place backtracking)\n          -b (always use the byte matrix instead of the bitboard for boards up to 64 fields)\n          -g (always use the generic kernel instead of the kernels specialised for a board size)\n          -p (prune subtrees that can't beat the longest path found so far)\n          -o (with -p: only search one longest path, the number of longest paths is not counted)\n          -r 2 (every 2 plies abandon paths that can't return to the root anymore)\n          -u (search each cycle only once from its smallest field, counts the distinct cycles)\n          -d 12 (spawn tasks only for paths with less than 12 fields, backtrack sequentially below)\n          -f 20 (spawn tasks only while more than 20 fields are free, backtrack sequentially below)\n          -a (calibrate the cut-off depth with a short probe run)\n          --progress 60 (print the progress to stderr every 60 seconds)\n          --deadline 3600 (stop after 3600 seconds with the longest path so far)\n          --lower-bound 50 (with -p: a closed path of length 50 is known, e.g. from the heuristic engine)\n          --min-length 50 (only search paths with at least 50 fields, stops at the first one)\n          --count-witnesses (with --min-length: count all paths with at least the minimum length)");
     }
     if((m < 4 || n < 4) &&  (m + n) < 8){
         err_abort("Calculation only works from boards with min size 5x3 of 4x4");
@@ -27,6 +26,7 @@ int main(int argc, char* argv[]) {
 
     LongestUncrossedKnightsPath algorithmn(m, n);
     algorithmn.limitThreads(t);
+    algorithmn.setSearchOptions(options);
 
     std::cout << "Running algorithmn over all fields on a " << (int) m << "x" << (int) n << " board." << std::endl;
     algorithmn.run();
@@ -37,16 +37,56 @@ int main(int argc, char* argv[]) {
     std::cout << "Elapsed time: " << elapsed_seconds.count() << " seconds." << std::endl;
 }
 
-void get_args(int argc, char *argv[], uint8_t &m, uint8_t &n, uint8_t& t) {
-    for(int i=1; i<argc; i+=2) {
-        if(strcmp(argv[i], "-m") == 0) {
-            m = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-n") == 0) {
-            n = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-t") == 0) {
-            t = strtol(argv[i+1], NULL, 10);
+/**
+  * @brief  Parses the command line arguments. Options with a value are given as pairs (-m 8), flags are given alone (-c).
+  * @retval true:   The arguments are valid
+  *         false:  An argument is unknown or the board size is missing
+  */
+bool get_args(int argc, char *argv[], uint8_t &m, uint8_t &n, uint8_t& t, SearchOptions& options) {
+    for(int i=1; i<argc; i++) {
+        bool hasValue = (i+1 < argc);
+        if(strcmp(argv[i], "-m") == 0 && hasValue) {
+            m = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-n") == 0 && hasValue) {
+            n = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-t") == 0 && hasValue) {
+            t = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-c") == 0) {
+            options.inPlace = false;
+        } else if(strcmp(argv[i], "-b") == 0) {
+            options.bitboard = false;
+        } else if(strcmp(argv[i], "-g") == 0) {
+            options.specialised = false;
+        } else if(strcmp(argv[i], "-p") == 0) {
+            options.bound = true;
+        } else if(strcmp(argv[i], "-o") == 0) {
+            options.countPaths = false;
+        } else if(strcmp(argv[i], "-r") == 0 && hasValue) {
+            options.reachability = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-u") == 0) {
+            options.canonical = true;
+        } else if(strcmp(argv[i], "-d") == 0 && hasValue) {
+            options.cutoffDepth = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-f") == 0 && hasValue) {
+            options.cutoffFree = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-a") == 0) {
+            options.calibrate = true;
+        } else if(strcmp(argv[i], "--progress") == 0 && hasValue) {
+            options.progressInterval = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--deadline") == 0 && hasValue) {
+            options.deadline = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--lower-bound") == 0 && hasValue) {
+            options.lowerBound = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--min-length") == 0 && hasValue) {
+            options.minLength = strtol(argv[++i], NULL, 10);
+            options.bound = true;
+        } else if(strcmp(argv[i], "--count-witnesses") == 0) {
+            options.countWitnesses = true;
+        } else {
+            return false;
         }
     }
+    return m > 0 && n > 0;
 }
 
 void err_abort (const char *str){ 
@@ -5,8 +5,16 @@
 #include <bitset>
 #include <iostream>
 
+#include "MoveTable.h"
+
 #define BORDER_OFFSET 2
 
+//Boards with up to 256 fields including the border (12x12) keep their fields inline, so a copy doesn't allocate
+#define CHESSBOARD_INLINE_FIELDS 256
+
+//The storage holds planes of the field count: the moves, the reserved moves and the crossings of each move of each field
+#define CHESSBOARD_PLANES (2 + MOVE_COUNT)
+
 class Chessboard {
     private:   
         uint8_t width;
@@ -15,19 +23,37 @@ class Chessboard {
         uint16_t totalWidth;
         uint16_t totalHeight;
         
-        std::vector<uint8_t> matrix;
+        //The fields are stored in cells, larger boards use the overflow vector. matrix points to the used one.
+        uint8_t cells[CHESSBOARD_PLANES * CHESSBOARD_INLINE_FIELDS];
+        std::vector<uint8_t> overflow;
+        uint8_t* matrix;
+
+        //The blocked moves of each field, they are updated with every change of a field. reserved: the moves whose target
+        //is part of the path or a border field (the root excluded). crossings: the number of edges that cross each move
+        //(MOVE_COUNT per field), so a removed edge only unblocks a move that no other edge crosses.
+        uint8_t* reserved;
+        uint8_t* crossings;
+        const MoveTable* moveTable;
         std::pair<uint8_t, uint8_t> root;
+        uint16_t rootIndex = 0;
 
         uint16_t length = 0;
+        void selectStorage();
         void setupFields();
+        void setupMoves();
+        void changeField(uint16_t, uint8_t);
+        void countCrossings(uint16_t, uint8_t, int8_t);
 
     public:
         Chessboard();
         Chessboard(uint8_t, uint8_t);
+        Chessboard(const Chessboard&);
+        Chessboard& operator=(const Chessboard&);
         virtual ~Chessboard();
 
         void setField(uint8_t, std::pair<uint8_t, uint8_t>);
         void updateField(uint8_t, std::pair<uint8_t, uint8_t>);
+        void unsetField(std::pair<uint8_t, uint8_t>);
         void setRoot(uint8_t, std::pair<uint8_t, uint8_t>);
 
         uint8_t at(uint8_t, uint8_t) const;
@@ -39,6 +65,7 @@ class Chessboard {
 
         uint16_t getTotalWidth() const;
         uint16_t getTotalHeight() const;
+        const MoveTable* getMoveTable() const;
 
         void debug() const;
 
@@ -51,6 +78,25 @@ class Chessboard {
         bool isFieldReserved(std::pair<uint8_t, uint8_t>) const;
         bool isCandidateConnected(uint8_t , uint8_t, uint8_t) const;
         bool isConnectionCrossesEdge(std::pair<uint8_t, uint8_t>, uint8_t) const;
+
+        //Flat field index (y * totalWidth + x). Used by the backtracking instead of positions.
+        uint16_t toIndex(std::pair<uint8_t, uint8_t>) const;
+        std::pair<uint8_t, uint8_t> toField(uint16_t) const;
+        uint16_t getRootIndex() const;
+
+        uint8_t at(uint16_t) const;
+        void setField(uint8_t, uint16_t);
+        void updateField(uint8_t, uint16_t);
+        void unsetField(uint16_t);
+        void blockFieldsBefore(uint16_t);
+
+        uint16_t doMove(uint16_t, uint8_t) const;
+        bool isFinishable(uint16_t, uint16_t, uint8_t) const;
+        bool isFieldReserved(uint16_t) const;
+        bool isConnectionCrossesEdge(uint16_t, uint8_t) const;
+        uint8_t getOpenMoves(uint16_t) const;
+        uint16_t countReachable(uint16_t, uint16_t) const;
+        bool isRootReachable(uint16_t) const;
 };
 
 #endif /* CHESSBOARD_H */
\ No newline at end of file
@@ -6,7 +6,9 @@
   * @param  n 	height of the chessboard
   * @retval None
   */
-LongestUncrossedKnightsPath::LongestUncrossedKnightsPath(uint8_t m, uint8_t n) : chessboard(m, n) { }
+LongestUncrossedKnightsPath::LongestUncrossedKnightsPath(uint8_t m, uint8_t n) : chessboard(m, n) {
+  this->threadProgress = &this->progress.local();
+}
 
 
 /**
@@ -15,26 +17,47 @@ LongestUncrossedKnightsPath::LongestUncrossedKnightsPath(uint8_t m, uint8_t n) :
 LongestUncrossedKnightsPath::~LongestUncrossedKnightsPath() {
 }
 
+/**
+  * @brief  Sets the options that select how the backtracking is executed.
+  * @param  _options The search options
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::setSearchOptions(const SearchOptions& _options) {
+  this->options = _options;
+}
+
 
 /**
   * @brief  Runs the algorithm for all starting fields.
   * Start field optimization: Iterates over all fields of the chessboard and determins which fields need to be selected as starting fields for the algoritmn.
   * This takes symmetries into concideration. For details see chapter 2.1 figure 6.
+  * In the canonical mode every field is a start field instead, see startFrom().
   * @param  None
   * @retval None
   */
 void LongestUncrossedKnightsPath::run() {
+  std::vector<std::pair<uint8_t, uint8_t>> roots;
+  if(this->options.canonical){
+    for(uint8_t y = 0; y < chessboard.getHeight(); ++y){
+      for(uint8_t x = 0; x < chessboard.getWidth(); ++x){
+        roots.push_back(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+      }
+    }
+    this->runFields(roots);
+    return;
+  }
+
   for(uint8_t x = 0; x <= (chessboard.getWidth()  - 1)/2; ++x){
      for(uint8_t y = 0; y<= (chessboard.getHeight() - 1)/2; ++y){
-      Chessboard cboard = chessboard;
       //Just take the lower left quadrant, the others can be rotated or mirrored on the horizontal and vertical axis.
       //For uneven sides the axis itself is also included.
       //Mirroring on the diagonal axis only works for boards with equal width and height
       if(y <= x || chessboard.getWidth() != chessboard.getHeight()){
-        startBacktracking(cboard, std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+        roots.push_back(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
       }
     }
-  }  
+  }
+  this->runFields(roots);
 }
 
 /**
@@ -42,7 +65,89 @@ void LongestUncrossedKnightsPath::run() {
   * @retval None
   */
 void LongestUncrossedKnightsPath::runFrom(uint8_t x, uint8_t y){
-  this->startBacktracking(this->chessboard, std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+  std::vector<std::pair<uint8_t, uint8_t>> roots;
+  roots.push_back(std::make_pair(x + BORDER_OFFSET, y + BORDER_OFFSET));
+  this->runFields(roots);
+}
+
+/**
+  * @brief  Starts the algorithm from the given start fields one after another. Each start field is a work unit of the progress.
+  * @param  roots The start fields
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::runFields(const std::vector<std::pair<uint8_t, uint8_t>>& roots){
+  if(this->options.progressInterval > 0){
+    this->progress.start(this->options.progressInterval, roots.size(), 0);
+  }
+  if(this->options.deadline > 0){
+    this->anytime.start(this->options.deadline);
+  }
+  this->anytime.addUnits(roots.size());
+
+  for(const std::pair<uint8_t, uint8_t>& root : roots){
+    if(this->anytime.isExpired()){
+      break;
+    }
+    this->startFrom(root);
+    this->progress.finishUnit(0, 0);
+
+    //A start field that was stopped by the deadline isn't searched completely
+    if(!this->anytime.isExpired()){
+      this->anytime.finishUnit();
+    }
+  }
+  this->progress.stop();
+  this->anytime.stop();
+}
+
+/**
+  * @brief  Starts the backtracking from a start field on a fresh copy of the chessboard.
+  *         Sizes with a specialised kernel use the FixedChessboard. Other boards with at most 64 fields
+  *         are represented as bitboard. Both can be disabled in the search options.
+  *         In the canonical mode all fields before the root are blocked, so a cycle is only found from its smallest field.
+  * @param  root The start field
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::startFrom(std::pair<uint8_t, uint8_t> root){
+  Chessboard cboard = this->chessboard;
+  if(this->options.canonical){
+    cboard.blockFieldsBefore(cboard.toIndex(root));
+  }
+  uint8_t moves = this->getStartingMoves(cboard, root);
+
+  if(this->options.specialised && this->startSpecialised(cboard, root, moves)){
+    return;
+  }
+
+  if(this->options.bitboard && Bitboard::fits(cboard.getWidth(), cboard.getHeight())){
+    Bitboard bboard(cboard);
+    this->startBacktracking(bboard, root, moves);
+  }else{
+    this->startBacktracking(cboard, root, moves);
+  }
+}
+
+/**
+  * @brief  Starts the backtracking with the kernel that is specialised for the board size.
+  * @param  cboard  The chessboard to start from
+  * @param  root    The start field
+  * @param  moves   The start moves
+  * @retval true:   There is a specialised kernel for the board size and the backtracking is done
+  *         false:  There is no specialised kernel, the generic one needs to be used
+  */
+bool LongestUncrossedKnightsPath::startSpecialised(Chessboard &cboard, std::pair<uint8_t, uint8_t> root, uint8_t moves){
+  switch(FIXED_CHESSBOARD_KEY(cboard.getWidth(), cboard.getHeight())){
+#define START_SPECIALISED(W, H) \
+    case FIXED_CHESSBOARD_KEY(W, H): { \
+      FixedChessboard<W, H> fboard(cboard); \
+      this->startBacktracking(fboard, root, moves); \
+      return true; \
+    }
+    FIXED_CHESSBOARD_SIZES(START_SPECIALISED)
+#undef START_SPECIALISED
+    default:
+      return false;
+  }
 }
 
 uint8_t LongestUncrossedKnightsPath::getStartingMoves(Chessboard &cboard, std::pair<uint8_t, uint8_t> root) {
@@ -56,10 +161,12 @@ uint8_t LongestUncrossedKnightsPath::getStartingMoves(Chessboard &cboard, std::p
 	if(cboard.at(target.first, target.second) != 0b11111111) { moves |= move;}
   }
 
-  //Optimize symmetric moves (diagonal, vertical, horizontal)
-  if(width == height && root.first == root.second)	{ moves &= 0b00011110; }
-  if((width % 2 == 1) && (root.first == (width/2)))	{ moves &= 0b00001111; }
-  if((height % 2 == 1) && (root.second == (height/2))){ moves &= 0b00111100; }
+  //Optimize symmetric moves (diagonal, vertical, horizontal). In the canonical mode every field is a root, so there are no symmetries.
+  if(!this->options.canonical){
+    if(width == height && root.first == root.second)	{ moves &= 0b00011110; }
+    if((width % 2 == 1) && (root.first == (width/2)))	{ moves &= 0b00001111; }
+    if((height % 2 == 1) && (root.second == (height/2))){ moves &= 0b00111100; }
+  }
 
   for(uint8_t move = 0b00000001; move > 0; move <<= 1) { if((move & moves) != 0) { count++; } }
   if(count < 2) { return moves; }
@@ -77,18 +184,27 @@ uint8_t LongestUncrossedKnightsPath::getStartingMoves(Chessboard &cboard, std::p
   * @brief  Starts the internal backtarcking process.
   * @param  cboard  The current chessboard instance
   * @param  root    The root to start the backtracking from
+  * @param  moves   The start moves, see getStartingMoves()
   * @retval None
   */
-void LongestUncrossedKnightsPath::startBacktracking(Chessboard &cboard, std::pair<uint8_t, uint8_t> root) {
-  uint8_t moves = this->getStartingMoves(cboard, root);
-
+template<typename Board>
+void LongestUncrossedKnightsPath::startBacktracking(Board &cboard, std::pair<uint8_t, uint8_t> root, uint8_t moves) {
   for(uint8_t move = 0b00000001; move > 0; move <<= 1) {
     if((move & moves) != 0){
-      Chessboard cpy = cboard;
-      cpy.setRoot(move, root);
-	  
-	  std::pair<uint8_t, uint8_t> target = cboard.doMove(cpy.getRoot(), move);
-      backtracking(cpy, target, move);
+      if(this->options.inPlace){
+        //The root is set on the board itself and removed again after its subtree is processed
+        cboard.setRoot(move, root);
+
+        uint16_t target = cboard.doMove(cboard.getRootIndex(), move);
+        backtrackingInPlace(cboard, target, move);
+        cboard.unsetField(cboard.getRootIndex());
+      }else{
+        Board cpy = cboard;
+        cpy.setRoot(move, root);
+
+        uint16_t target = cboard.doMove(cpy.getRootIndex(), move);
+        backtracking(cpy, target, move);
+      }
     }
   }
 }
@@ -96,52 +212,277 @@ void LongestUncrossedKnightsPath::startBacktracking(Chessboard &cboard, std::pai
 /**
   * @brief  The actual bactracking. In each iteration a node is processed.
   * @param  cboard        The current copy of the chessboard
-  * @param  source        The current field
+  * @param  source        The field index of the current field
   * @param  incoming_move The current move that leads to source
   * @retval None
   */
-void LongestUncrossedKnightsPath::backtracking(Chessboard &cboard, std::pair<uint8_t, uint8_t> source, uint8_t incoming_move) {
+template<typename Board>
+void LongestUncrossedKnightsPath::backtracking(Board &cboard, uint16_t source, uint8_t incoming_move) {
+  this->threadProgress->addNode();
+  if(this->anytime.isExpired()){
+    return;
+  }
+  if(this->options.bound && this->isPrunable(cboard, source)){
+    return;
+  }
+  if(this->options.reachability > 0 && this->isDisconnected(cboard, source)){
+    return;
+  }
 
-  for(uint8_t outgoing_move = 0b00000001; outgoing_move > 0; outgoing_move <<= 1) {
-    std::pair<uint8_t, uint8_t> target = cboard.doMove(source, outgoing_move);
+  //Only the open moves are processed, lowest bit first. A move to the root is open if it doesn't cross an edge.
+  for(uint8_t open = cboard.getOpenMoves(source); open != 0; open &= open - 1) {
+    uint8_t outgoing_move = open & -open;
+    uint16_t target = cboard.doMove(source, outgoing_move);
 
-    if(!cboard.isFieldReserved(target) && !cboard.isConnectionCrossesEdge(source, outgoing_move)) {
+    if(target != cboard.getRootIndex()) {
       //The next move is valid, so it gets stored in a new board copy
       uint8_t moves = outgoing_move | cboard.rotate180(incoming_move);
-      Chessboard cpy = cboard;
+      Board cpy = cboard;
       cpy.setField(moves, source);
 
       //The next backtracking iteration with the new move and target node gets started
       this->backtracking(cpy, target, outgoing_move);
-    }else if(cboard.isFinishable(source, target, outgoing_move)) {
+    }else if(this->isCanonicalClosing(cboard, outgoing_move)) {
       //The board can be finised. The finishing move gets stored in a new board copy
       uint8_t moves = outgoing_move | cboard.rotate180(incoming_move);
-      Chessboard cpy = cboard;
-	    std::pair<uint8_t, uint8_t> root = cpy.getRoot();
+      Board cpy = cboard;
+	    uint16_t root = cpy.getRootIndex();
       cpy.setField(moves, source);
-      cpy.updateField((cpy.at(root.first, root.second) | cboard.rotate180(outgoing_move)), root);
-
-      //Check if the completed path is of an important length
-      if(cpy.getLength() == this->longestPathLength){
-        this->longestPathBoards.push_back(cpy);
-      }else if(cpy.getLength() > this->longestPathLength){
-        this->longestPathLength = cpy.getLength();
-        this->longestPathBoards.clear();
-        this->longestPathBoards.push_back(cpy);
-      }
+      cpy.updateField((cpy.at(root) | cboard.rotate180(outgoing_move)), root);
+
+      this->storePath(cpy);
+    }
+  }
+}
+
+
+/**
+  * @brief  The in-place variant of the backtracking. Instead of copying the chessboard for every valid move,
+  *         the move is set on the given board and reverted after the subtree was processed. So the board
+  *         is in the same state when the method returns as it was when it was called.
+  * @param  cboard        The chessboard that is shared by the whole search
+  * @param  source        The field index of the current field
+  * @param  incoming_move The current move that leads to source
+  * @retval None
+  * @see    backtracking()
+  */
+template<typename Board>
+void LongestUncrossedKnightsPath::backtrackingInPlace(Board &cboard, uint16_t source, uint8_t incoming_move) {
+  this->threadProgress->addNode();
+  if(this->anytime.isExpired()){
+    return;
+  }
+  if(this->options.bound && this->isPrunable(cboard, source)){
+    return;
+  }
+  if(this->options.reachability > 0 && this->isDisconnected(cboard, source)){
+    return;
+  }
+
+  uint8_t incoming = cboard.rotate180(incoming_move);
+
+  //Only the open moves are processed, lowest bit first. A move to the root is open if it doesn't cross an edge.
+  for(uint8_t open = cboard.getOpenMoves(source); open != 0; open &= open - 1) {
+    uint8_t outgoing_move = open & -open;
+    uint16_t target = cboard.doMove(source, outgoing_move);
+
+    if(target != cboard.getRootIndex()) {
+      //The next move is valid, so it gets stored on the board until the subtree is processed
+      cboard.setField(outgoing_move | incoming, source);
+      this->backtrackingInPlace(cboard, target, outgoing_move);
+      cboard.unsetField(source);
+    }else if(this->isCanonicalClosing(cboard, outgoing_move)) {
+      //The board can be finished. The finishing move is set temporarily to check and store the path.
+      uint16_t root = cboard.getRootIndex();
+      uint8_t rootMoves = cboard.at(root);
+      cboard.setField(outgoing_move | incoming, source);
+      cboard.updateField(rootMoves | cboard.rotate180(outgoing_move), root);
+
+      this->storePath(cboard);
+
+      cboard.updateField(rootMoves, root);
+      cboard.unsetField(source);
     }
-    //else { Field is used or crosses path -> do nothing}
   }
 }
 
+/**
+  * @brief  Stores a closed path if it is of an important length. The progress shows the longest paths right away,
+  *         not only after the start field is finished, since a single start field can take minutes on large boards.
+  * @param  cboard The chessboard with the closed path
+  * @retval None
+  */
+template<typename Board>
+void LongestUncrossedKnightsPath::storePath(Board &cboard){
+  if(cboard.getLength() == this->longestPathLength){
+    this->longestPathBoards.push_back(static_cast<Chessboard>(cboard));
+  }else if(cboard.getLength() > this->longestPathLength){
+    this->longestPathLength = cboard.getLength();
+    this->longestPathBoards.clear();
+    this->longestPathBoards.push_back(static_cast<Chessboard>(cboard));
+    this->offerPath();
+  }
+  this->progress.setLongest(this->longestPathLength, this->longestPathBoards.size());
+  this->checkWitness(cboard.getLength());
+}
+
+/**
+  * @brief  Writes a new longest path to the file of the longest path so far, if the search has a deadline.
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::offerPath(){
+  if(this->options.deadline > 0){
+    this->anytime.offerPath(this->longestPathBoards.back());
+  }
+}
+
+/**
+  * @brief  Counts a closed path if it has at least the minimum length. Without counting the witnesses, the first one stops the search.
+  *         Every path found before it is shorter, so the witness is the longest path and exported as usual.
+  * @param  length The length of the closed path
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::checkWitness(uint16_t length){
+  if(this->options.minLength == 0 || length < this->options.minLength){
+    return;
+  }
+  this->witnessCount++;
+  if(!this->options.countWitnesses){
+    this->anytime.stopEarly();
+  }
+}
+
+/**
+  * @brief  The length that a path needs to reach to be searched further: the longest path so far, or the next longer length
+  *         if the paths aren't counted. With a minimum length it is the minimum length instead.
+  * @param  None
+  * @retval The length limit of the branch and bound
+  */
+uint16_t LongestUncrossedKnightsPath::getBoundLimit() const {
+  uint16_t limit = this->options.countPaths ? this->longestPathLength : this->longestPathLength + 1;
+  limit = std::max(limit, this->options.lowerBound);
+  if(this->options.minLength > 0){
+    limit = this->options.minLength;
+  }
+  //A closed path alternates between the two field colors, so its length is even
+  return limit + (limit & 1);
+}
+
+/**
+  * @brief  Checks whether the subtree of a node can be pruned. The path can at most be extended by the free fields
+  *         that are reachable from source over open moves, so the current length plus their number is an upper bound
+  *         for its length. If the root can't be reached anymore, the path can't be closed at all.
+  *         With a minimum length it is the limit instead of the longest path. The check runs every BOUND_INTERVAL plies.
+  * @param  cboard  The current chessboard
+  * @param  source  The field index of the current field
+  * @retval true:   The subtree can't beat the longest path (or reach its length, if the paths are counted)
+  *         false:  The subtree needs to be processed
+  */
+template<typename Board>
+bool LongestUncrossedKnightsPath::isPrunable(Board &cboard, uint16_t source) {
+  uint16_t limit = this->getBoundLimit();
+  if(cboard.getLength() % BOUND_INTERVAL != 0 || cboard.getLength() + 1 >= limit){
+    return false;
+  }
+
+  uint16_t needed = limit - cboard.getLength();
+  return cboard.countReachable(source, needed) < needed;
+}
+
+/**
+  * @brief  In the canonical mode each cycle is only accepted in one direction: the move that closes the cycle
+  *         needs to be a larger move of the root than the first move. Otherwise every closing move is accepted.
+  * @param  cboard        The current chessboard
+  * @param  outgoing_move The move that closes the cycle
+  * @retval true:   The cycle is accepted
+  *         false:  The cycle is found in the other direction
+  */
+template<typename Board>
+bool LongestUncrossedKnightsPath::isCanonicalClosing(Board &cboard, uint8_t outgoing_move) {
+  return !this->options.canonical || cboard.rotate180(outgoing_move) > cboard.at(cboard.getRootIndex());
+}
+
+/**
+  * @brief  Checks every k plies whether the path can still return to the root. If it can't, the subtree is cut.
+  *         If the bound of -p was checked on this ply, it already covers the root, so it isn't searched twice.
+  * @param  cboard  The current chessboard
+  * @param  source  The field index of the current field
+  * @retval true:   The root can't be reached anymore, the subtree can be pruned
+  *         false:  The subtree needs to be processed
+  */
+template<typename Board>
+bool LongestUncrossedKnightsPath::isDisconnected(Board &cboard, uint16_t source) {
+  if(cboard.getLength() % this->options.reachability != 0){
+    return false;
+  }
+  if(this->options.bound && cboard.getLength() % BOUND_INTERVAL == 0 && cboard.getLength() + 1 < this->getBoundLimit()){
+    return false;
+  }
+
+  bool disconnected = !cboard.isRootReachable(source);
+  this->reachabilityStats.checked++;
+  this->reachabilityStats.pruned += disconnected;
+  return disconnected;
+}
+
+//Explicit instantiations of the specialised kernels
+#define INSTANTIATE_SPECIALISED(W, H) \
+  template void LongestUncrossedKnightsPath::startBacktracking<FixedChessboard<W, H>>(FixedChessboard<W, H>&, std::pair<uint8_t, uint8_t>, uint8_t);
+FIXED_CHESSBOARD_SIZES(INSTANTIATE_SPECIALISED)
+#undef INSTANTIATE_SPECIALISED
 
 /**
   * @brief  Exports the longest path.
   * @param  None
   * @retval None
   */
-void LongestUncrossedKnightsPath::exportLongestPath() const{
-  std::cout << "Longest Path is " << this->longestPathLength << " with " << this->longestPathBoards.size() << " variations." << std::endl;
+void LongestUncrossedKnightsPath::exportLongestPath(){
+  this->anytime.report();
+  if(this->options.minLength > 0){
+    this->exportWitness();
+    return;
+  }
+  if(this->longestPathBoards.empty()){
+    std::cout << "No path was found." << std::endl;
+    return;
+  }
+
+  if(this->options.countPaths){
+    std::cout << "Longest Path is " << this->longestPathLength << " with " << this->longestPathBoards.size() << " variations." << std::endl;
+  }else{
+    std::cout << "Longest Path is " << this->longestPathLength << "." << std::endl;
+  }
+
+  if(this->options.reachability > 0){
+    std::cout << "Reachability pruning cut " << this->reachabilityStats.pruned << " of " << this->reachabilityStats.checked << " checked nodes." << std::endl;
+  }
+
+  FileExporter fileExporter;
+  Chessboard out = longestPathBoards[0];
+  fileExporter.exportPath(out, 1);
+}
+
+/**
+  * @brief  Prints whether a path with at least the minimum length exists (or how many there are) and exports the longest one.
+  * @param  None
+  * @retval None
+  */
+void LongestUncrossedKnightsPath::exportWitness(){
+  uint16_t minLength = this->options.minLength;
+  if(this->witnessCount == 0){
+    if(this->anytime.isExpired()){
+      std::cout << "No path with at least " << minLength << " fields was found." << std::endl;
+    }else{
+      std::cout << "There is no path with at least " << minLength << " fields." << std::endl;
+    }
+    return;
+  }
+
+  if(this->options.countWitnesses){
+    std::cout << "There are " << this->witnessCount << " paths with at least " << minLength << " fields, the longest has " << this->longestPathLength << " fields." << std::endl;
+  }else{
+    std::cout << "A path with at least " << minLength << " fields exists, it has " << this->longestPathLength << " fields." << std::endl;
+  }
 
   FileExporter fileExporter;
   Chessboard out = longestPathBoards[0];
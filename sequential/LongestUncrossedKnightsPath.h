@@ -5,30 +5,62 @@
 #include <stdint.h>
 
 #include "Chessboard.h"
+#include "Bitboard.h"
+#include "FixedChessboard.h"
 #include "FileExporter.h"
+#include "SearchOptions.h"
+#include "PruningStats.h"
+#include "ProgressReporter.h"
+#include "AnytimeSearch.h"
 
 class LongestUncrossedKnightsPath {
  
     private:
         Chessboard chessboard;
+        SearchOptions options;
+        PruningStats reachabilityStats;
+
+        //The progress of the search, the nodes are counted for the reporter
+        ProgressReporter progress;
+        ThreadProgress* threadProgress;
+
+        //The deadline of the search and its longest path so far
+        AnytimeSearch anytime;
 
         uint16_t longestPathLength = 0;
         std::vector<Chessboard> longestPathBoards;
 
+        //The number of paths with at least the minimum length, see SearchOptions::minLength
+        uint64_t witnessCount = 0;
+
         uint8_t getStartingMoves(Chessboard&, std::pair<uint8_t, uint8_t>);
-        void startBacktracking(Chessboard&, std::pair<uint8_t, uint8_t>);
-        void backtracking(Chessboard&, std::pair<uint8_t, uint8_t>, uint8_t);
+        void runFields(const std::vector<std::pair<uint8_t, uint8_t>>&);
+        void startFrom(std::pair<uint8_t, uint8_t>);
+        bool startSpecialised(Chessboard&, std::pair<uint8_t, uint8_t>, uint8_t);
+        template<typename Board> void startBacktracking(Board&, std::pair<uint8_t, uint8_t>, uint8_t);
+        template<typename Board> void backtracking(Board&, uint16_t, uint8_t);
+        template<typename Board> void backtrackingInPlace(Board&, uint16_t, uint8_t);
+        uint16_t getBoundLimit() const;
+        template<typename Board> bool isPrunable(Board&, uint16_t);
+        template<typename Board> bool isDisconnected(Board&, uint16_t);
+        template<typename Board> bool isCanonicalClosing(Board&, uint8_t);
 
         void checkForLongestPath(Chessboard&);
+        template<typename Board> void storePath(Board&);
+        void offerPath();
+        void checkWitness(uint16_t);
+        void exportWitness();
 
     public:
         LongestUncrossedKnightsPath(uint8_t, uint8_t);
         virtual ~LongestUncrossedKnightsPath();
 
+        void setSearchOptions(const SearchOptions&);
+
         void run();
         void runFrom(uint8_t x, uint8_t y);
 
-        void exportLongestPath() const;
+        void exportLongestPath();
 };
 
 #endif /* LONGESTUNCROSSEDKNIGHTSPATH_H */
@@ -0,0 +1,42 @@
+#include "MoveTable.h"
+
+#include <vector>
+
+#define MOVE_TABLE_MAX_WIDTH 260
+
+//The tables are defined in the header, so that they are known at compile time
+constexpr int8_t MoveTable::moveDx[MOVE_COUNT];
+constexpr int8_t MoveTable::moveDy[MOVE_COUNT];
+constexpr int8_t MoveTable::neighbourDx[MOVE_COUNT][NEIGHBOUR_COUNT];
+constexpr int8_t MoveTable::neighbourDy[MOVE_COUNT][NEIGHBOUR_COUNT];
+constexpr uint8_t MoveTable::neighbourMask[MOVE_COUNT][NEIGHBOUR_COUNT];
+constexpr uint8_t MoveTable::crossingMove[MOVE_COUNT][CROSSING_COUNT];
+constexpr int8_t MoveTable::crossingDx[MOVE_COUNT][CROSSING_COUNT];
+constexpr int8_t MoveTable::crossingDy[MOVE_COUNT][CROSSING_COUNT];
+
+/**
+  * @brief  Calculates the flat index deltas for a row length.
+  * @param  totalWidth The row length of the board, including the borders
+  */
+MoveTable::MoveTable(uint16_t totalWidth) {
+  for(uint8_t i = 0; i < MOVE_COUNT; i++) {
+    moveOffset[i] = moveDx[i] + moveDy[i] * totalWidth;
+    for(uint8_t j = 0; j < CROSSING_COUNT; j++) {
+      crossingOffset[i][j] = crossingDx[i][j] + crossingDy[i][j] * totalWidth;
+    }
+  }
+}
+
+/**
+  * @brief  Returns the move table for a row length. All tables are calculated once on the first call.
+  * @param  totalWidth The row length of the board, including the borders
+  * @retval The move table
+  */
+const MoveTable* MoveTable::forWidth(uint16_t totalWidth) {
+  static const std::vector<MoveTable> tables = [] {
+    std::vector<MoveTable> t;
+    for(uint16_t w = 0; w < MOVE_TABLE_MAX_WIDTH; w++) { t.push_back(MoveTable(w)); }
+    return t;
+  }();
+  return &tables[totalWidth < MOVE_TABLE_MAX_WIDTH ? totalWidth : 0];
+}
@@ -0,0 +1,72 @@
+#ifndef PROGRESSREPORTER_H
+#define PROGRESSREPORTER_H
+
+#include "stdint.h"
+#include <iostream>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/**
+ * The number of nodes that one thread visited. Only its thread writes it, so a relaxed load and store are enough
+ * and the reporter can read it at any time. Each counter is on its own cache line.
+ */
+class alignas(64) ThreadProgress {
+public:
+	std::atomic<uint64_t> nodes{0};
+
+	inline void addNode() {
+		this->nodes.store(this->nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+};
+
+/**
+ * Prints the progress of a running search to stderr in a fixed interval: the finished work units, the visited nodes
+ * per second, the longest path so far and the estimated remaining time. A background thread samples the counters,
+ * the search itself only writes its own counters.
+ * The remaining time is estimated from the finished share of the estimated work, or of the work units if there is no estimate.
+ */
+class ProgressReporter {
+
+private:
+	//Identifies the reporter for the thread local lookup of the counters
+	uint64_t id;
+
+	std::deque<ThreadProgress> threads;
+	std::mutex threadsMutex;
+
+	std::atomic<uint64_t> totalUnits{0};
+	std::atomic<uint64_t> finishedUnits{0};
+	std::atomic<uint64_t> finishedNodes{0};
+	std::atomic<double> totalEstimate{0};
+	std::atomic<double> finishedEstimate{0};
+
+	//The longest length in the upper 16 bits and the number of paths of this length in the lower 48 bits
+	std::atomic<uint64_t> longest{0};
+
+	std::thread writer;
+	std::mutex mutex;
+	std::condition_variable stopped;
+	bool running = false;
+
+	void print(double, double);
+
+public:
+	ProgressReporter();
+	~ProgressReporter();
+
+	void start(uint32_t, uint64_t, double);
+	void stop();
+
+	ThreadProgress& local();
+	uint64_t countNodes();
+	void addUnits(uint64_t);
+	void finishUnit(uint64_t, double);
+	void mergeLongest(uint16_t, uint64_t);
+	void setLongest(uint16_t, uint64_t);
+};
+
+#endif /* PROGRESSREPORTER_H */
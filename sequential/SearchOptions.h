@@ -0,0 +1,69 @@
+#ifndef SEARCHOPTIONS_H
+#define SEARCHOPTIONS_H
+
+#include "stdint.h"
+
+//With the bound the subtrees are only checked every BOUND_INTERVAL plies. A check costs more than a node,
+//the pruned subtrees are small and a subtree that is missed is mostly found one ply later.
+#define BOUND_INTERVAL 2
+
+/**
+ * Data class that stores the options that select how the backtracking is executed.
+ */
+class SearchOptions {
+public:
+	//true:  One chessboard per worker is changed in place and restored when returning from a node
+	//false: Every node works on its own copy of the chessboard
+	bool inPlace = true;
+
+	//true:  Boards with at most 64 fields are represented as Bitboard
+	//false: The byte matrix of the Chessboard is used for all board sizes
+	bool bitboard = true;
+
+	//true:  Board sizes with a specialised kernel use the FixedChessboard
+	//false: The generic kernel is used for all board sizes
+	bool specialised = true;
+
+	//true:  Subtrees that can't get longer than the longest path found so far are pruned (branch and bound),
+	//       see BOUND_INTERVAL
+	//false: All paths are visited
+	bool bound = false;
+
+	//true:  All longest paths are counted, so the pruning only removes subtrees that can't reach the longest length
+	//false: Only one longest path is searched and the pruning also removes subtrees that can only reach the same length
+	bool countPaths = true;
+
+	//k > 0: Every k plies the path is abandoned if the root can't be reached anymore from the current field
+	//0:     The reachability of the root isn't checked
+	uint8_t reachability = 0;
+
+	//true:  Every field is a root, but a cycle is only searched from its field with the smallest index and in one direction.
+	//       The fields before the root are blocked. The number of longest paths is the exact number of distinct cycles.
+	//false: Only the start fields that are left after the symmetry optimization are roots
+	bool canonical = false;
+
+	//s > 0: Every s seconds the progress of the search is printed to stderr, see ProgressReporter
+	//0:     No progress is printed
+	uint32_t progressInterval = 0;
+
+	//s > 0: The search stops after s seconds with the longest path so far, which is also written to paths/MxN_best.path
+	//       whenever it gets longer, see AnytimeSearch
+	//0:     The search runs until it is complete
+	uint32_t deadline = 0;
+
+	//L > 0: A closed path of length L is known to exist, e.g. from the heuristic engine. With -p the subtrees
+	//       that can't reach L are pruned from the start
+	//0:     Only the paths of the search are used as bound
+	uint16_t lowerBound = 0;
+
+	//L > 0: Only paths with at least L fields are searched, the subtrees that can't reach L are pruned and the search
+	//       stops at the first such path (the witness)
+	//0:     The longest path is searched
+	uint16_t minLength = 0;
+
+	//true:  With a minimum length all witnesses are counted instead of stopping at the first one
+	//false: The search stops at the first witness
+	bool countWitnesses = false;
+};
+
+#endif /* SEARCHOPTIONS_H */
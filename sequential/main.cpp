@@ -7,21 +7,17 @@
 
 #include "LongestUncrossedKnightsPath.h"
 
-void get_args(int, char*[], uint8_t&, uint8_t&);
-void get_args(int, char*[], uint8_t&, uint8_t&, uint8_t&, uint8_t&);
+bool get_args(int, char*[], uint8_t&, uint8_t&, uint8_t&, uint8_t&, bool&, SearchOptions&);
 
 void err_abort (const char*);
 
 int main(int argc, char* argv[]) {
     
     uint8_t m = 0, n = 0, x = 0, y = 0;
-    bool withStartfield = (argc == 8+1);
-    if(argc == (4+1)){
-        get_args(argc, argv, m, n);
-    }else if(argc == (8+1)){
-        get_args(argc, argv, m, n, x, y);
-    }else{
-        err_abort("Valid are: \nWith all startfields: -m 4 -n 4\nWith single given start field: -m 4 -n 4 -x 0 -y 0");
+    bool withStartfield = false;
+    SearchOptions options;
+    if(!get_args(argc, argv, m, n, x, y, withStartfield, options)){
+        err_abort("Valid are: \nWith all startfields: -m 4 -n 4\nWith single given start field: -m 4 -n 4 -x 0 -y 0\nOptional: -c (copy the board for every move instead of in-place backtracking)\n          -b (always use the byte matrix instead of the bitboard for boards up to 64 fields)\n          -g (always use the generic kernel instead of the kernels specialised for a board size)\n          -p (prune subtrees that can't beat the longest path found so far)\n          -o (with -p: only search one longest path, the number of longest paths is not counted)\n          -r 2 (every 2 plies abandon paths that can't return to the root anymore)\n          -u (search each cycle only once from its smallest field, counts the distinct cycles)\n          --progress 60 (print the progress to stderr every 60 seconds)\n          --deadline 3600 (stop after 3600 seconds with the longest path so far)\n          --lower-bound 50 (with -p: a closed path of length 50 is known, e.g. from the heuristic engine)\n          --min-length 50 (only search paths with at least 50 fields, stops at the first one)\n          --count-witnesses (with --min-length: count all paths with at least the minimum length)");
     }
     if((m < 4 || n < 4) &&  (m + n) < 8){
         err_abort("Calculation only works from boards with min size 5x3 or 4x4");
@@ -30,6 +26,7 @@ int main(int argc, char* argv[]) {
     auto start = std::chrono::system_clock::now();
 
     LongestUncrossedKnightsPath algorithmn(m, n);
+    algorithmn.setSearchOptions(options);
     if(!withStartfield){
         std::cout << "Running algorithmn over all fields on a " << (int) m << "x" << (int) n << " board." << std::endl;
         algorithmn.run();
@@ -45,28 +42,54 @@ int main(int argc, char* argv[]) {
     algorithmn.exportLongestPath();
 }
 
-void get_args(int argc, char *argv[], uint8_t &m, uint8_t &n) {
-    for(int i=1; i<argc; i+=2) {
-        if(strcmp(argv[i], "-m") == 0) {
-            m = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-n") == 0) {
-            n = strtol(argv[i+1], NULL, 10);
-        }
-    }
-}
-
-void get_args(int argc, char *argv[], uint8_t& m, uint8_t& n, uint8_t& x, uint8_t& y) {
-    for(int i=1; i<argc; i+=2) {
-        if(strcmp(argv[i], "-m") == 0) {
-            m = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-n") == 0) {
-            n = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-x") == 0) {
-            x = strtol(argv[i+1], NULL, 10);
-        } else if(strcmp(argv[i], "-y") == 0) {
-            y = strtol(argv[i+1], NULL, 10);
+/**
+  * @brief  Parses the command line arguments. Options with a value are given as pairs (-m 8), flags are given alone (-c).
+  * @retval true:   The arguments are valid
+  *         false:  An argument is unknown or the board size is missing
+  */
+bool get_args(int argc, char *argv[], uint8_t& m, uint8_t& n, uint8_t& x, uint8_t& y, bool& withStartfield, SearchOptions& options) {
+    bool withX = false, withY = false;
+    for(int i=1; i<argc; i++) {
+        bool hasValue = (i+1 < argc);
+        if(strcmp(argv[i], "-m") == 0 && hasValue) {
+            m = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-n") == 0 && hasValue) {
+            n = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-x") == 0 && hasValue) {
+            x = strtol(argv[++i], NULL, 10); withX = true;
+        } else if(strcmp(argv[i], "-y") == 0 && hasValue) {
+            y = strtol(argv[++i], NULL, 10); withY = true;
+        } else if(strcmp(argv[i], "-c") == 0) {
+            options.inPlace = false;
+        } else if(strcmp(argv[i], "-b") == 0) {
+            options.bitboard = false;
+        } else if(strcmp(argv[i], "-g") == 0) {
+            options.specialised = false;
+        } else if(strcmp(argv[i], "-p") == 0) {
+            options.bound = true;
+        } else if(strcmp(argv[i], "-o") == 0) {
+            options.countPaths = false;
+        } else if(strcmp(argv[i], "-r") == 0 && hasValue) {
+            options.reachability = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-u") == 0) {
+            options.canonical = true;
+        } else if(strcmp(argv[i], "--progress") == 0 && hasValue) {
+            options.progressInterval = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--deadline") == 0 && hasValue) {
+            options.deadline = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--lower-bound") == 0 && hasValue) {
+            options.lowerBound = strtol(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--min-length") == 0 && hasValue) {
+            options.minLength = strtol(argv[++i], NULL, 10);
+            options.bound = true;
+        } else if(strcmp(argv[i], "--count-witnesses") == 0) {
+            options.countWitnesses = true;
+        } else {
+            return false;
         }
     }
+    withStartfield = withX && withY;
+    return m > 0 && n > 0 && (withX == withY);
 }
 
 void err_abort (const char *str){ 